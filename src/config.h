@@ -24,21 +24,84 @@ const int output27 = 27;
 
 // Serial configuration
 #define SERIAL_BAUD 115200
-const uint8_t numChars = 32;
+const uint8_t numChars = 48;  // Longest command line (a full 'sa' aspect table is 38)
 
 // EEPROM configuration
 #define EEPROM_SIZE 1024  // Increased size for WiFi configuration storage
+#define EEPROM_WRITE_DELAY_MS 2000        // Commit once settings have been unchanged this long
+#define EEPROM_WRITE_MAX_DELAY_MS 10000   // ...or at the latest this long after the first change
+#define EEPROM_COMMIT_COUNT_ADDRESS (EEPROM_SIZE - 4)  // Lifetime commit counter (last 4 bytes)
+#define CONFIG_JOURNAL_PARTITION "config"  // Flash partition holding the settings journal (partitions.csv)
+#define SERVO_STATE_PARTITION "state"      // Flash partition holding the last settled servo states (partitions.csv)
+#define SERVO_STATE_WRITE_DELAY_MS 1000    // Write the states once they have stopped changing for this long
 
 // Timing constants
 #define SERVO_UPDATE_INTERVAL 15  // milliseconds
+
+// Servo task (runs updateServos at a fixed rate, independent of loop())
+#define SERVO_TASK_CORE 1         // Application core (WiFi/lwIP run on core 0)
+#define SERVO_TASK_PRIORITY 3     // Above the Arduino loop task (priority 1)
+#define SERVO_TASK_STACK_SIZE 4096
 #define LED_BLINK_CYCLES 33       // 15ms * 33 = ~495ms
 #define HEARTBEAT_INTERVAL 1000   // milliseconds - heartbeat blink rate
 #define DCC_SIGNAL_DURATION 100   // milliseconds - DCC signal LED on duration
-#define DCC_LOG_SIZE 50           // DCC debug log buffer size
+#define DCC_LOG_SIZE 2048         // DCC debug log records, 8 bytes each (power of two)
+#define DCC_LOG_WEB_ENTRIES 100   // Most recent records shown on the web debug page
+#define DCC_REPEAT_WINDOW_MS 500  // Repeats of an accessory command (same address and direction) within this are ignored
+#define DCC_CAPTURE_SIZE 1024     // Raw packet capture ring, 12 bytes per packet (power of two)
+#define DCC_CAPTURE_FILE "/dcc-capture.bin"  // Capture spilled to LittleFS (spiffs partition)
+#define DCC_CAPTURE_SPILL_BATCH 64           // Packets written to the file at a time
+#define DCC_CAPTURE_FILE_MAX (512UL * 1024UL)  // Capture stops when the file reaches this size
+#define SERVO_COMMAND_QUEUE_SIZE 32  // Pending servo commands (power of two)
+#define WEB_PAGE_CHUNK_SIZE 1024  // Stack buffer for one chunk of a streamed web page
+
+// Diagnostic output (leveled, rate-limited, drained to Serial by a low-priority task)
+#define DIAG_LEVEL_MAX 4          // Compile-time ceiling: 0=none 1=error 2=warn 3=info 4=debug
+#define DIAG_LEVEL_DEFAULT 3      // Runtime level at boot (info; debug adds per-packet DCC messages)
+#define DIAG_RING_SIZE 2048       // Bytes of queued output (power of two)
+#define DIAG_LINE_MAX 96          // Longest message, newline included
+#define DIAG_RATE_PER_SEC 20      // Sustained messages per second...
+#define DIAG_BURST 32             // ...after a burst of this many
+#define DIAG_TASK_CORE 0          // Protocol core: the Arduino loop never blocks, so core 1 has no idle time to drain in
+#define DIAG_TASK_PRIORITY 1      // Far below WiFi/lwIP (output only goes out when the core is otherwise idle)
+#define DIAG_TASK_STACK_SIZE 3072
+#define DIAG_DRAIN_INTERVAL_MS 10
 
 // Servo constants
 #define SERVO_CENTER_POSITION 90  // Default center position (degrees)
 #define SERVO_MAX_OFFSET 45       // Absolute maximum offset from center (+/- degrees)
                                   // Note: Actual offset limit is 50% of swing angle, whichever is smaller
+#define SERVO_ASPECT_COUNT 8      // Signal aspect positions per servo (extended accessory packets)
+#define SERVO_ASPECT_UNUSED 0xFF  // Aspect table entry with no position; packets for it are ignored
+
+// Servo pulse range (ESP32Servo defaults), 0-180 degrees maps linearly onto it
+#define SERVO_MIN_PULSE_US 544
+#define SERVO_MAX_PULSE_US 2400
+#define SERVO_PULSE_FRAC_BITS 8   // Motion engine keeps pulse widths in 1/256 microsecond steps
+
+// Speed presets in degrees/second (same travel rate as the old 3/2/1 degrees per 15ms update)
+#define SERVO_SPEED_FAST_DPS 200
+#define SERVO_SPEED_NORMAL_DPS 133
+#define SERVO_SPEED_SLOW_DPS 67
+#define SERVO_MAX_SPEED_DPS 1000  // Upper limit for an explicit degrees/second speed
+
+// Boot sequence: servos are driven to their closed position a group at a time
+#define SERVO_BOOT_GROUP_SIZE 4   // Servos booted together (keep within the PSU inrush limit)
+#define SERVO_BOOT_HOLD_MS 500    // Time each group is held before the next group starts
+#define SERVO_BOOT_REPORT 1       // 1 = print a one-line summary when boot completes
+
+// Move scheduler: servos beyond this many wait their turn (protects the 5V rail from brownouts)
+#define SERVO_MAX_CONCURRENT_MOVES 4
+
+// Live event push (WebSocket)
+#define EVENT_BUS_SIZE 64             // Recent servo/DCC events kept for clients (power of two)
+#define EVENT_SOCKET_PORT 81
+#define EVENT_SOCKET_BATCH 16         // Most events sent to one client in one frame
+#define EVENT_SOCKET_SEND_MS 50       // Minimum time between event frames to one client
+#define EVENT_SOCKET_HEALTH_MS 2000   // Health counter push interval
+
+// JSON REST API (/api/v1/...)
+#define WEB_API_VERSION 1
+#define WEB_API_DOC_SIZE 3072         // Request document, allocated once (about 16 servo changes or 40 commands)
 
 #endif // CONFIG_H
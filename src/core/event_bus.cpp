@@ -0,0 +1,51 @@
+#include "event_bus.h"
+
+static_assert((EVENT_BUS_SIZE & (EVENT_BUS_SIZE - 1)) == 0, "EVENT_BUS_SIZE must be a power of two");
+
+// Global instance
+EventBus eventBus;
+
+EventBus::EventBus()
+    : nextSequence(0) {
+}
+
+void EventBus::publish(uint8_t type, uint16_t id, uint8_t value) {
+    uint32_t now = millis();
+    
+    portENTER_CRITICAL(&mux);
+    BusEvent &event = events[nextSequence & (EVENT_BUS_SIZE - 1)];
+    event.timestamp = now;
+    event.id = id;
+    event.type = type;
+    event.value = value;
+    nextSequence++;
+    portEXIT_CRITICAL(&mux);
+}
+
+bool EventBus::get(uint32_t sequence, BusEvent &event) {
+    bool valid;
+    
+    portENTER_CRITICAL(&mux);
+    uint32_t age = nextSequence - sequence;
+    valid = (age != 0) && (age <= EVENT_BUS_SIZE);
+    if (valid) {
+        event = events[sequence & (EVENT_BUS_SIZE - 1)];
+    }
+    portEXIT_CRITICAL(&mux);
+    
+    return valid;
+}
+
+uint32_t EventBus::getFirstSequence() {
+    portENTER_CRITICAL(&mux);
+    uint32_t first = (nextSequence > EVENT_BUS_SIZE) ? nextSequence - EVENT_BUS_SIZE : 0;
+    portEXIT_CRITICAL(&mux);
+    return first;
+}
+
+uint32_t EventBus::getNextSequence() {
+    portENTER_CRITICAL(&mux);
+    uint32_t next = nextSequence;
+    portEXIT_CRITICAL(&mux);
+    return next;
+}
@@ -0,0 +1,80 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include "../config.h"
+
+// Published event types
+enum busEventType : uint8_t {
+    BUS_EVENT_SERVO_STATE,  // id = servo number, value = servoState
+    BUS_EVENT_DCC_MATCH,    // id = DCC address, value = direction
+    BUS_EVENT_DCC_ASPECT    // id = DCC address, value = signal aspect
+};
+
+// Subscription topics
+#define BUS_TOPIC_SERVO 0x01
+#define BUS_TOPIC_DCC 0x02
+#define BUS_TOPIC_HEALTH 0x04
+
+// Compact event record
+struct BusEvent {
+    uint32_t timestamp;     // millis()
+    uint16_t id;
+    uint8_t type;           // busEventType
+    uint8_t value;
+};
+
+/**
+ * @brief Ring of recent servo and DCC events for push clients
+ * 
+ * Published from the servo task (state transitions) and the DCC callback
+ * (matched packets). Readers keep their own sequence cursor, as with the DCC
+ * debug log, so a reader that falls behind loses the oldest events rather
+ * than holding anything up: publishing never waits for readers.
+ */
+class EventBus {
+private:
+    BusEvent events[EVENT_BUS_SIZE];
+    uint32_t nextSequence;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;  // Servo task and main loop both publish
+
+public:
+    /**
+     * @brief Construct an empty event bus
+     */
+    EventBus();
+
+    /**
+     * @brief Publish an event (servo task or main loop)
+     */
+    void publish(uint8_t type, uint16_t id, uint8_t value);
+
+    /**
+     * @brief Read an event by sequence number
+     * @return false if it has been overwritten or not yet published
+     */
+    bool get(uint32_t sequence, BusEvent &event);
+
+    /**
+     * @brief Sequence number of the oldest event still held
+     */
+    uint32_t getFirstSequence();
+
+    /**
+     * @brief Sequence number the next event will get
+     */
+    uint32_t getNextSequence();
+
+    /**
+     * @brief Topic an event type belongs to
+     */
+    static uint8_t getTopic(uint8_t type) {
+        return (type == BUS_EVENT_SERVO_STATE) ? BUS_TOPIC_SERVO : BUS_TOPIC_DCC;
+    }
+};
+
+// Global instance
+extern EventBus eventBus;
+
+#endif // EVENT_BUS_H
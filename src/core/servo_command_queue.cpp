@@ -0,0 +1,56 @@
+#include "servo_command_queue.h"
+
+static_assert((SERVO_COMMAND_QUEUE_SIZE & (SERVO_COMMAND_QUEUE_SIZE - 1)) == 0,
+              "SERVO_COMMAND_QUEUE_SIZE must be a power of two");
+
+// Global instance
+ServoCommandQueue servoCommandQueue;
+
+ServoCommandQueue::ServoCommandQueue()
+    : head(0)
+    , tail(0)
+    , pushedCount(0)
+    , droppedCount(0)
+    , coalescedCount(0)
+    , peakDepth(0) {
+}
+
+bool ServoCommandQueue::push(uint16_t servoMask, uint8_t target, uint8_t source) {
+    uint16_t h = head.load(std::memory_order_relaxed);
+    uint16_t depth = (uint16_t)(h - tail.load(std::memory_order_acquire));
+    
+    if (depth >= SERVO_COMMAND_QUEUE_SIZE) {
+        droppedCount++;
+        return false;
+    }
+    
+    ServoCommand &slot = ring[h & (SERVO_COMMAND_QUEUE_SIZE - 1)];
+    slot.servoMask = servoMask;
+    slot.target = target;
+    slot.source = source;
+    slot.timestamp = millis();
+    
+    // Publish the slot to the consumer
+    head.store((uint16_t)(h + 1), std::memory_order_release);
+    
+    pushedCount++;
+    if (depth + 1 > peakDepth) peakDepth = depth + 1;
+    return true;
+}
+
+bool ServoCommandQueue::pop(ServoCommand &command) {
+    uint16_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+        return false;
+    }
+    
+    command = ring[t & (SERVO_COMMAND_QUEUE_SIZE - 1)];
+    
+    // Release the slot back to the producer
+    tail.store((uint16_t)(t + 1), std::memory_order_release);
+    return true;
+}
+
+uint16_t ServoCommandQueue::getDepth() const {
+    return (uint16_t)(head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire));
+}
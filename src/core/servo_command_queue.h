@@ -0,0 +1,99 @@
+#ifndef SERVO_COMMAND_QUEUE_H
+#define SERVO_COMMAND_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "../config.h"
+
+// Requested servo targets
+enum servoCommandTarget : uint8_t {
+    SERVO_CMD_CLOSE,
+    SERVO_CMD_THROW,
+    SERVO_CMD_NEUTRAL,
+    SERVO_CMD_TOGGLE,
+    SERVO_CMD_ASPECT    // Signal aspect n is SERVO_CMD_ASPECT + n (n < SERVO_ASPECT_COUNT)
+};
+
+// Flag OR'd into a target: jump the move queue (e.g. a turnout under a train)
+#define SERVO_CMD_PRIORITY 0x80
+#define SERVO_CMD_TARGET_MASK 0x7F
+
+// Where a command came from
+enum servoCommandSource : uint8_t {
+    SERVO_SRC_DCC,
+    SERVO_SRC_DCC_EMULATION,
+    SERVO_SRC_SERIAL,
+    SERVO_SRC_WEB
+};
+
+// Compact servo command record
+struct ServoCommand {
+    uint16_t servoMask;     // Bit n = virtualservo[n]
+    uint8_t target;         // servoCommandTarget, optionally | SERVO_CMD_PRIORITY
+    uint8_t source;         // servoCommandSource
+    uint32_t timestamp;     // millis() when queued
+};
+
+/**
+ * @brief Lock-free single-producer/single-consumer servo command ring
+ * 
+ * All command sources (DCC callback, serial and web handlers) run in the main
+ * loop and push here; the servo engine is the only consumer and drains the ring
+ * once per tick. Commands are applied in the order they were queued.
+ */
+class ServoCommandQueue {
+private:
+    ServoCommand ring[SERVO_COMMAND_QUEUE_SIZE];
+    std::atomic<uint16_t> head;     // Next write slot, owned by the producer
+    std::atomic<uint16_t> tail;     // Next read slot, owned by the consumer
+    
+    // Statistics (each written by one side only)
+    uint32_t pushedCount;
+    uint32_t droppedCount;
+    uint32_t coalescedCount;
+    uint16_t peakDepth;
+
+public:
+    /**
+     * @brief Construct an empty queue
+     */
+    ServoCommandQueue();
+
+    /**
+     * @brief Queue a command (producer side)
+     * @param servoMask Servos to command
+     * @param target Requested target (servoCommandTarget)
+     * @param source Command origin (servoCommandSource)
+     * @return false if the ring was full and the command was dropped
+     */
+    bool push(uint16_t servoMask, uint8_t target, uint8_t source);
+
+    /**
+     * @brief Take the oldest command (consumer side)
+     * @param command Receives the command
+     * @return false if the ring is empty
+     */
+    bool pop(ServoCommand &command);
+
+    /**
+     * @brief Record servos whose earlier command was superseded in the same tick
+     * @param count Number of superseded servo commands
+     */
+    void addCoalesced(uint8_t count) { coalescedCount += count; }
+
+    /**
+     * @brief Get number of commands currently queued
+     * @return Queue depth
+     */
+    uint16_t getDepth() const;
+
+    uint32_t getPushedCount() const { return pushedCount; }
+    uint32_t getDroppedCount() const { return droppedCount; }
+    uint32_t getCoalescedCount() const { return coalescedCount; }
+    uint16_t getPeakDepth() const { return peakDepth; }
+};
+
+// Global instance
+extern ServoCommandQueue servoCommandQueue;
+
+#endif // SERVO_COMMAND_QUEUE_H
@@ -0,0 +1,94 @@
+#include "servo_move_scheduler.h"
+
+static_assert(SERVO_MAX_CONCURRENT_MOVES >= 1, "At least one servo must be allowed to move");
+
+// Global instance
+ServoMoveScheduler servoMoveScheduler;
+
+ServoMoveScheduler::ServoMoveScheduler()
+    : queueHead(0)
+    , queueCount(0)
+    , movingMask(0)
+    , waitingMask(0)
+    , maxConcurrent(SERVO_MAX_CONCURRENT_MOVES)
+    , peakMoving(0)
+    , peakWaiting(0)
+    , deferredCount(0)
+    , priorityCount(0) {
+}
+
+bool ServoMoveScheduler::request(uint8_t servo, bool priority) {
+    uint16_t bit = 1U << servo;
+    if (movingMask & bit) return true;
+    
+    // Free slot and nobody waiting - go straight away
+    if ((queueCount == 0) && (getMovingCount() < maxConcurrent)) {
+        movingMask |= bit;
+        if (getMovingCount() > peakMoving) peakMoving = getMovingCount();
+        return true;
+    }
+    
+    if (waitingMask & bit) {
+        if (!priority) return false;  // Keep its place
+        removeWaiting(servo);
+    } else {
+        deferredCount++;
+    }
+    
+    enqueue(servo, priority);
+    if (priority) priorityCount++;
+    return false;
+}
+
+void ServoMoveScheduler::release(uint8_t servo) {
+    uint16_t bit = 1U << servo;
+    movingMask &= ~bit;
+    if (waitingMask & bit) {
+        removeWaiting(servo);
+    }
+}
+
+uint16_t ServoMoveScheduler::admit() {
+    uint16_t admitted = 0;
+    
+    while ((queueCount > 0) && (getMovingCount() < maxConcurrent)) {
+        uint8_t servo = queue[queueHead];
+        queueHead = (queueHead + 1) % TOTAL_PINS;
+        queueCount--;
+        
+        uint16_t bit = 1U << servo;
+        waitingMask &= ~bit;
+        movingMask |= bit;
+        admitted |= bit;
+    }
+    
+    if (getMovingCount() > peakMoving) peakMoving = getMovingCount();
+    return admitted;
+}
+
+void ServoMoveScheduler::enqueue(uint8_t servo, bool priority) {
+    if (priority) {
+        queueHead = (queueHead + TOTAL_PINS - 1) % TOTAL_PINS;
+        queue[queueHead] = servo;
+    } else {
+        queue[(queueHead + queueCount) % TOTAL_PINS] = servo;
+    }
+    queueCount++;
+    waitingMask |= 1U << servo;
+    
+    if (queueCount > peakWaiting) peakWaiting = queueCount;
+}
+
+void ServoMoveScheduler::removeWaiting(uint8_t servo) {
+    // Close the gap, keeping everyone else in order
+    uint8_t kept = 0;
+    for (uint8_t n = 0; n < queueCount; n++) {
+        uint8_t entry = queue[(queueHead + n) % TOTAL_PINS];
+        if (entry != servo) {
+            queue[(queueHead + kept) % TOTAL_PINS] = entry;
+            kept++;
+        }
+    }
+    queueCount = kept;
+    waitingMask &= ~(1U << servo);
+}
@@ -0,0 +1,74 @@
+#ifndef SERVO_MOVE_SCHEDULER_H
+#define SERVO_MOVE_SCHEDULER_H
+
+#include <Arduino.h>
+#include "../config.h"
+
+/**
+ * @brief Limits how many servos move at once
+ * 
+ * A servo must hold a move slot while it travels. At most maxConcurrent slots
+ * are handed out; the rest wait in a first-come-first-served queue and are
+ * admitted as moves finish. A priority request (e.g. a turnout under a train)
+ * goes to the front of the queue.
+ * 
+ * Owned by the servo engine and only used from the servo tick.
+ */
+class ServoMoveScheduler {
+private:
+    uint8_t queue[TOTAL_PINS];      // Waiting servos, oldest at queueHead
+    uint8_t queueHead;
+    uint8_t queueCount;
+    uint16_t movingMask;            // Servos holding a move slot
+    uint16_t waitingMask;           // Servos in the queue
+    uint8_t maxConcurrent;
+    
+    // Statistics
+    uint8_t peakMoving;
+    uint8_t peakWaiting;
+    uint32_t deferredCount;         // Requests that had to wait
+    uint32_t priorityCount;         // Requests that jumped the queue
+
+    void enqueue(uint8_t servo, bool priority);
+    void removeWaiting(uint8_t servo);
+
+public:
+    /**
+     * @brief Construct a scheduler allowing SERVO_MAX_CONCURRENT_MOVES moves
+     */
+    ServoMoveScheduler();
+
+    /**
+     * @brief Ask for a move slot
+     * @param servo Servo slot
+     * @param priority Go to the front of the queue
+     * @return true if the servo may move now, false if it is queued
+     */
+    bool request(uint8_t servo, bool priority);
+
+    /**
+     * @brief Give back a servo's slot, or take it out of the queue
+     * @param servo Servo slot
+     */
+    void release(uint8_t servo);
+
+    /**
+     * @brief Hand free slots to the oldest waiting servos
+     * @return Bitmask of servos admitted by this call
+     */
+    uint16_t admit();
+
+    bool isMoving(uint8_t servo) const { return movingMask & (1U << servo); }
+    uint8_t getMovingCount() const { return __builtin_popcount(movingMask); }
+    uint8_t getWaitingCount() const { return queueCount; }
+    uint8_t getMaxConcurrent() const { return maxConcurrent; }
+    uint8_t getPeakMoving() const { return peakMoving; }
+    uint8_t getPeakWaiting() const { return peakWaiting; }
+    uint32_t getDeferredCount() const { return deferredCount; }
+    uint32_t getPriorityCount() const { return priorityCount; }
+};
+
+// Global instance
+extern ServoMoveScheduler servoMoveScheduler;
+
+#endif // SERVO_MOVE_SCHEDULER_H
@@ -0,0 +1,115 @@
+#include "servo_task.h"
+#include "../config.h"
+#include "../servo_controller.h"
+
+// Global instance
+ServoTask servoTask;
+
+ServoTask::ServoTask()
+    : taskHandle(nullptr)
+    , configMutex(nullptr) {
+    resetStats();
+}
+
+void ServoTask::begin() {
+    if (taskHandle != nullptr) return;
+    
+    if (configMutex == nullptr) {
+        configMutex = xSemaphoreCreateMutex();
+    }
+    
+    BaseType_t result = xTaskCreatePinnedToCore(taskEntry, "servo", SERVO_TASK_STACK_SIZE, this,
+                                                SERVO_TASK_PRIORITY, &taskHandle, SERVO_TASK_CORE);
+    if (result != pdPASS) {
+        taskHandle = nullptr;
+        Serial.println("✗ Failed to start servo task");
+        return;
+    }
+    
+    Serial.printf("Servo task started on core %d (%d ms interval)\n", SERVO_TASK_CORE, SERVO_UPDATE_INTERVAL);
+}
+
+void ServoTask::taskEntry(void *param) {
+    ServoTask *self = static_cast<ServoTask *>(param);
+    TickType_t lastWake = xTaskGetTickCount();
+    
+    for (;;) {
+        self->tick();
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SERVO_UPDATE_INTERVAL));
+    }
+}
+
+void ServoTask::tick() {
+    uint32_t startUs = micros();
+    
+    // Period since the previous tick started
+    if (lastTickUs != 0) {
+        uint32_t periodUs = startUs - lastTickUs;
+        if (periodUs < minPeriodUs) minPeriodUs = periodUs;
+        if (periodUs > maxPeriodUs) maxPeriodUs = periodUs;
+        totalPeriodUs += periodUs;
+        periodCount++;
+        
+        // Late = more than half an interval behind schedule
+        if (periodUs > (SERVO_UPDATE_INTERVAL * 1500UL)) {
+            lateTicks++;
+        }
+    }
+    lastTickUs = startUs;
+    
+    lock();
+    bool wasIdle = (getActiveServoMask() == 0);
+    uint32_t startCycles = ESP.getCycleCount();
+    updateServos();
+    uint32_t cycles = ESP.getCycleCount() - startCycles;
+    // A tick that drained a command has left servos active
+    bool idle = wasIdle && (getActiveServoMask() == 0);
+    unlock();
+    
+    if (idle) {
+        idleTicks++;
+        idleCycles += cycles;
+        if (cycles > maxIdleCycles) maxIdleCycles = cycles;
+    } else {
+        activeTicks++;
+        activeCycles += cycles;
+    }
+    
+    uint32_t runUs = micros() - startUs;
+    if (runUs > maxRunUs) maxRunUs = runUs;
+}
+
+void ServoTask::lock() {
+    if (configMutex != nullptr) {
+        xSemaphoreTake(configMutex, portMAX_DELAY);
+    }
+}
+
+void ServoTask::unlock() {
+    if (configMutex != nullptr) {
+        xSemaphoreGive(configMutex);
+    }
+}
+
+void ServoTask::resetStats() {
+    lastTickUs = 0;
+    minPeriodUs = UINT32_MAX;
+    maxPeriodUs = 0;
+    totalPeriodUs = 0;
+    periodCount = 0;
+    lateTicks = 0;
+    maxRunUs = 0;
+    idleTicks = 0;
+    idleCycles = 0;
+    maxIdleCycles = 0;
+    activeTicks = 0;
+    activeCycles = 0;
+}
+
+ServoConfigLock::ServoConfigLock() {
+    servoTask.lock();
+}
+
+ServoConfigLock::~ServoConfigLock() {
+    servoTask.unlock();
+}
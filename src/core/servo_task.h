@@ -0,0 +1,112 @@
+#ifndef SERVO_TASK_H
+#define SERVO_TASK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+/**
+ * @brief Fixed-rate servo engine task
+ * 
+ * Runs updateServos() every SERVO_UPDATE_INTERVAL from its own FreeRTOS task,
+ * paced by vTaskDelayUntil, so servo motion no longer depends on how quickly
+ * loop() comes back around (web requests, WiFi scans, serial commands).
+ * 
+ * Also keeps tick period statistics so timing jitter can be inspected, and the
+ * cycle cost of idle ticks (no servo active) versus ticks that moved servos.
+ */
+class ServoTask {
+private:
+    TaskHandle_t taskHandle;
+    SemaphoreHandle_t configMutex;
+    
+    // Tick period statistics (microseconds)
+    uint32_t lastTickUs;
+    uint32_t minPeriodUs;
+    uint32_t maxPeriodUs;
+    uint64_t totalPeriodUs;
+    uint32_t periodCount;
+    uint32_t lateTicks;
+    uint32_t maxRunUs;
+    
+    // updateServos() cost in CPU cycles, split by whether any servo had work
+    uint32_t idleTicks;
+    uint64_t idleCycles;
+    uint32_t maxIdleCycles;
+    uint32_t activeTicks;
+    uint64_t activeCycles;
+
+public:
+    /**
+     * @brief Construct the servo task (not started)
+     */
+    ServoTask();
+
+    /**
+     * @brief Create the task, pinned to SERVO_TASK_CORE
+     */
+    void begin();
+
+    /**
+     * @brief Run one servo tick and record its timing
+     * 
+     * Called by the task; exposed so a host build can drive ticks directly.
+     */
+    void tick();
+
+    /**
+     * @brief Lock the servo configuration against the servo tick
+     */
+    void lock();
+
+    /**
+     * @brief Release the servo configuration lock
+     */
+    void unlock();
+
+    /**
+     * @brief Clear the tick period statistics
+     */
+    void resetStats();
+
+    /**
+     * @brief Check if the task is running
+     * @return true once begin() has created the task
+     */
+    bool isRunning() const { return taskHandle != nullptr; }
+
+    uint32_t getTickCount() const { return periodCount; }
+    uint32_t getMinPeriodUs() const { return periodCount ? minPeriodUs : 0; }
+    uint32_t getMaxPeriodUs() const { return maxPeriodUs; }
+    uint32_t getAvgPeriodUs() const { return periodCount ? (uint32_t)(totalPeriodUs / periodCount) : 0; }
+    uint32_t getLateTicks() const { return lateTicks; }
+    uint32_t getMaxRunUs() const { return maxRunUs; }
+    uint32_t getIdleTicks() const { return idleTicks; }
+    uint32_t getAvgIdleCycles() const { return idleTicks ? (uint32_t)(idleCycles / idleTicks) : 0; }
+    uint32_t getMaxIdleCycles() const { return maxIdleCycles; }
+    uint32_t getActiveTicks() const { return activeTicks; }
+    uint32_t getAvgActiveCycles() const { return activeTicks ? (uint32_t)(activeCycles / activeTicks) : 0; }
+
+private:
+    /**
+     * @brief FreeRTOS task entry point
+     */
+    static void taskEntry(void *param);
+};
+
+/**
+ * @brief Scoped lock for changing virtualservo[] configuration
+ */
+class ServoConfigLock {
+public:
+    ServoConfigLock();
+    ~ServoConfigLock();
+    ServoConfigLock(const ServoConfigLock &) = delete;
+    ServoConfigLock &operator=(const ServoConfigLock &) = delete;
+};
+
+// Global instance
+extern ServoTask servoTask;
+
+#endif // SERVO_TASK_H
@@ -3,6 +3,7 @@
 #include "../servo_controller.h"
 #include "../eeprom_manager.h"
 #include "../wifi_controller.h"
+#include "servo_task.h"
 
 // Global instance
 SystemManager systemManager;
@@ -28,6 +29,9 @@ void SystemManager::begin() {
     initializeHardware();
     initializeTiming();
     
+    // Servo motion runs in its own fixed-rate task from here on
+    servoTask.begin();
+    
     isInitialized = true;
     Serial.println("✅ System Manager initialization complete");
 }
@@ -90,9 +94,6 @@ void SystemManager::updateTiming() {
             // Optional: Blink status LEDs
             // digitalWrite(output26, ledState ? HIGH : LOW);
         }
-        
-        // Update all servo positions
-        updateServos();
     }
 }
 
@@ -101,8 +102,10 @@ void SystemManager::triggerDccSignal() {
         ledController->triggerDccSignal();
     }
     
-    // Add to debug log
-    dccDebugLogger.addMessage("DCC signal triggered");
+    // Add to debug log (only while it is being watched, like the packets)
+    if (dccDebugLogger.isDebugEnabled()) {
+        dccDebugLogger.logSignal();
+    }
 }
 
 void SystemManager::toggleDccDebug() {
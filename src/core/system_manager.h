@@ -87,7 +87,7 @@ private:
     void initializeTiming();
 
     /**
-     * @brief Update system timing and servo operations
+     * @brief Update system timing (servo motion runs in the servo task)
      */
     void updateTiming();
 
@@ -2,10 +2,15 @@
 #include "servo_controller.h"
 #include "config.h"
 #include "utils/dcc_debug_logger.h"
+#include "utils/diag_log.h"
+#include "utils/dcc_capture.h"
+#include "utils/dcc_repeat_filter.h"
+#include "utils/dcc_address_index.h"
+#include "core/servo_command_queue.h"
+#include "core/event_bus.h"
 
 // External functions from main.cpp
 extern void triggerDccSignal();
-extern void addDccLogMessage(const String& message);
 
 // Global DCC objects
 NmraDcc Dcc;
@@ -26,7 +31,7 @@ void initializeDCC() {
 
     // Call the main DCC Init function to enable the DCC Receiver
     Dcc.init(MAN_ID_DIY, 10, CV29_ACCESSORY_DECODER | CV29_OUTPUT_ADDRESS_MODE, 0);
-    Serial.println("DCC Init Done");
+    DIAG_INFO("DCC Init Done");
 }
 
 void processDCC() {
@@ -38,78 +43,96 @@ void processDCC() {
     }
 }
 
-// DCC callback functions
-void notifyDccAccTurnoutBoard(uint16_t BoardAddr, uint8_t OutputPair, uint8_t Direction, uint8_t OutputPower) {
-    Serial.print("notifyDccAccTurnoutBoard: ");
-    Serial.print(BoardAddr, DEC);
-    Serial.print(',');
-    Serial.print(OutputPair, DEC);
-    Serial.print(',');
-    Serial.print(Direction, DEC);
-    Serial.print(',');
-    Serial.println(OutputPower, HEX);
-    // Does nothing more, we are not using it
-}
+// Common to both addressing modes and both packet types; address is as the
+// command station numbers it, target the servo command the packet asks for
+static void dispatchAccessory(uint16_t address, uint16_t servoMask, uint8_t target, uint8_t OutputPower) {
+    bool isOurAddress = (servoMask != 0);
+    bool isAspect = (target >= SERVO_CMD_ASPECT);
 
-void notifyDccAccTurnoutOutput(uint16_t Addr, uint8_t Direction, uint8_t OutputPower) {
-    // Check if this address matches any of our configured servos
-    bool isOurAddress = false;
-    for (auto &sv : virtualservo) {
-        if (Addr == sv.address && sv.address != 0) {
-            isOurAddress = true;
-            break;
-        }
-    }
+    // Repeats of a command we already acted on change nothing: drop them before any work
+    if (isOurAddress && !dccRepeatFilter.accept(address, target)) return;
     
     // Only trigger signal indication for our configured addresses
     if (isOurAddress) {
         triggerDccSignal();
     }
     
-    // Debug output if enabled
+    // Debug output if enabled (binary record, formatted when the log is read)
     if (dccDebugLogger.isDebugEnabled()) {
-        String debugMsg = "Addr=" + String(Addr) + ", Dir=" + String(Direction) + 
-                         ", Pwr=" + String(OutputPower, HEX) + (isOurAddress ? " [MATCH]" : " [ignore]");
-        Serial.print("DCC RX: ");
-        Serial.println(debugMsg);
-        addDccLogMessage(debugMsg);
+        if (isAspect) {
+            dccDebugLogger.logAspectPacket(address, target - SERVO_CMD_ASPECT, isOurAddress);
+        } else {
+            dccDebugLogger.logPacket(address, target, OutputPower, isOurAddress);
+        }
     }
 
     if (!isOurAddress) return;  // Only process packets for our addresses
 
-    VIRTUALSERVO *targetVirtualServo = nullptr;
-
-    // Act on the data, first locate the appropriate servo slot
-    for (auto &sv : virtualservo) {
-        if (Addr == sv.address) {
-            targetVirtualServo = &sv;
-            
-            if (targetVirtualServo == nullptr) continue;
-            
-            // Take action. 0 is closed, 1 thrown
-            if (Direction == 0) {
-                targetVirtualServo->state = SERVO_TO_CLOSED;
+    // Hand the command to the servo engine
+    servoCommandQueue.push(servoMask, target, SERVO_SRC_DCC);
+    if (isAspect) {
+        eventBus.publish(BUS_EVENT_DCC_ASPECT, address, target - SERVO_CMD_ASPECT);
+    } else {
+        eventBus.publish(BUS_EVENT_DCC_MATCH, address, target);
+    }
+    
+    if (dccDebugLogger.isDebugEnabled()) {
+        for (uint16_t mask = servoMask; mask; mask &= mask - 1) {
+            uint8_t pin = virtualservo[__builtin_ctz(mask)].pin;
+            if (isAspect) {
+                dccDebugLogger.logServoAspect(pin, target - SERVO_CMD_ASPECT);
             } else {
-                targetVirtualServo->state = SERVO_TO_THROWN;
-            }
-            
-            if (dccDebugLogger.isDebugEnabled()) {
-                String servoMsg = "Servo action: Pin " + String(targetVirtualServo->pin) + 
-                                " -> " + String(Direction == 0 ? "CLOSED" : "THROWN");
-                Serial.println(servoMsg);
-                addDccLogMessage(servoMsg);
+                dccDebugLogger.logServoAction(pin, target);
             }
         }
     }
 }
 
-#ifdef NOTIFY_DCC_MSG
+// DCC callback functions. NmraDcc makes both calls for every accessory
+// packet; each addressing mode dispatches from one of them
+void notifyDccAccTurnoutBoard(uint16_t BoardAddr, uint8_t OutputPair, uint8_t Direction, uint8_t OutputPower) {
+    DIAG_DEBUG("notifyDccAccTurnoutBoard: %u,%u,%u,%X", BoardAddr, OutputPair, Direction, OutputPower);
+    if (!dccAddressIndex.isBoardMode()) return;
+
+    // Range check against the claimed block - no per-address lookup
+    // 0 is closed, 1 thrown
+    dispatchAccessory(dccAddressIndex.toStationAddress(BoardAddr, OutputPair),
+                      dccAddressIndex.lookupBoard(BoardAddr, OutputPair),
+                      Direction == 0 ? SERVO_CMD_CLOSE : SERVO_CMD_THROW, OutputPower);
+}
+
+void notifyDccAccTurnoutOutput(uint16_t Addr, uint8_t Direction, uint8_t OutputPower) {
+    if (dccAddressIndex.isBoardMode()) return;
+
+    // Single index lookup - foreign addresses resolve to an empty servo mask
+    uint16_t address = dccAddressIndex.toStationAddress(Addr);
+    dispatchAccessory(address, dccAddressIndex.lookup(address), Direction == 0 ? SERVO_CMD_CLOSE : SERVO_CMD_THROW,
+                      OutputPower);
+}
+
+// Extended accessory (signal aspect) packet. NmraDcc only reports these by
+// output address, so this serves both addressing modes; the aspect is looked
+// up in the servo's precomputed table when the command is applied.
+void notifyDccSigOutputState(uint16_t Addr, uint8_t State) {
+    DIAG_DEBUG("notifyDccSigOutputState: %u,%u", Addr, State);
+    if (State >= SERVO_ASPECT_COUNT) return;  // Beyond any servo's table
+
+    uint16_t address = dccAddressIndex.toStationAddress(Addr);
+    dispatchAccessory(address, dccAddressIndex.lookup(address), SERVO_CMD_ASPECT + State, 1);
+}
+
+// Every decoded packet, before it is dispatched
 void notifyDccMsg(DCC_MSG *Msg) {
-    Serial.print("notifyDccMsg: ");
-    for (uint8_t i = 0; i < Msg->Size; i++) {
-        Serial.print(Msg->Data[i], HEX);
-        Serial.write(' ');
+    dccCapture.record(Msg->Data, Msg->Size);
+    
+#ifdef NOTIFY_DCC_MSG
+    if (!diagLog.isEnabled(DIAG_LEVEL_DEBUG)) return;
+    
+    char bytes[3 * MAX_DCC_MESSAGE_LEN + 1] = "";
+    size_t length = 0;
+    for (uint8_t i = 0; i < Msg->Size && i < MAX_DCC_MESSAGE_LEN; i++) {
+        length += snprintf(bytes + length, sizeof(bytes) - length, "%X ", Msg->Data[i]);
     }
-    Serial.println();
-}
+    DIAG_DEBUG("notifyDccMsg: %s", bytes);
 #endif
+}
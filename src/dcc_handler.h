@@ -22,9 +22,7 @@ void processDCC();
 // DCC callback functions
 void notifyDccAccTurnoutBoard(uint16_t BoardAddr, uint8_t OutputPair, uint8_t Direction, uint8_t OutputPower);
 void notifyDccAccTurnoutOutput(uint16_t Addr, uint8_t Direction, uint8_t OutputPower);
-
-#ifdef NOTIFY_DCC_MSG
+void notifyDccSigOutputState(uint16_t Addr, uint8_t State);
 void notifyDccMsg(DCC_MSG *Msg);
-#endif
 
 #endif // DCC_HANDLER_H
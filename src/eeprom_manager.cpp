@@ -2,53 +2,393 @@
 #include "servo_controller.h"
 #include "wifi_controller.h"
 #include "config.h"
+#include "core/servo_task.h"
+#include "utils/servo_easing.h"
+#include "hardware/servo_output.h"
+#include "utils/eeprom_writer.h"
+#include "utils/config_journal.h"
+#include "utils/crc32.h"
+#include "utils/dcc_address_index.h"
+#include "settings_layouts.h"
 #include <EEPROM.h>
+#include <stddef.h>
 
 // Global controller objects
 CONTROLLER bootController;
 CONTROLLER m_defaultController;
 
+// WiFi settings found by getSettings(), taken up by loadWiFiConfig()
+static WiFiConfig storedWiFi;
+static bool storedWiFiValid = false;
+
+// ---------------------------------------------------------------------------
+// Record decoders, one per layout version (see settings_layouts.h)
+// ---------------------------------------------------------------------------
+
+static void setDefaultServoSettings(VIRTUALSERVO &s) {
+    s.address = 0;  // Default to no DCC address assigned
+    s.invert = false;
+    s.position = 90;
+    s.swing = 25;
+    s.offset = 0;
+    s.speed = SERVO_SPEED_NORMAL_DPS;
+    s.easing = EASING_LINEAR;
+    s.continuous = false;
+    setDefaultServoAspects(s.aspects);
+    s.state = SERVO_BOOT;
+}
+
+// v1, v0.4.x: speed was a 0-3 preset index
+static void decodeServoV1(const uint8_t *entry, VIRTUALSERVO &s) {
+    LegacyServoV4 stored;
+    memcpy(&stored, entry, sizeof(stored));
+    s.address = stored.address;
+    s.swing = stored.swing;
+    s.offset = stored.offset;
+    s.speed = getServoSpeedPreset(stored.speed);
+    s.easing = EASING_LINEAR;
+    s.invert = stored.invert;
+    s.continuous = stored.continuous;
+    s.position = stored.position;
+}
+
+// v2, tagged records
+static void decodeServoV2(const uint8_t *entry, VIRTUALSERVO &s) {
+    ServoRecordV2 stored;
+    memcpy(&stored, entry, sizeof(stored));
+    s.address = stored.address;
+    s.swing = stored.swing;
+    s.offset = stored.offset;
+    s.speed = stored.speed;
+    s.easing = stored.easing;
+    s.invert = (stored.flags & SERVO_RECORD_INVERT) != 0;
+    s.continuous = (stored.flags & SERVO_RECORD_CONTINUOUS) != 0;
+    memcpy(s.aspects, stored.aspects, SERVO_ASPECT_COUNT);
+}
+
+struct ServoRecordFormat {
+    uint8_t version;
+    uint8_t entrySize;
+    void (*decode)(const uint8_t *entry, VIRTUALSERVO &s);
+};
+
+static const ServoRecordFormat servoRecordFormats[] = {
+    {1, sizeof(LegacyServoV4), decodeServoV1},
+    {SERVO_RECORD_VERSION, sizeof(ServoRecordV2), decodeServoV2},
+};
+
+// Servos past the end of the record keep their defaults
+static bool decodeServos(uint8_t version, const uint8_t *payload, uint16_t length) {
+    for (const ServoRecordFormat &format : servoRecordFormats) {
+        if (format.version != version) continue;
+
+        uint16_t count = length / format.entrySize;
+        for (uint16_t i = 0; i < count && i < TOTAL_PINS; i++) {
+            format.decode(payload + i * format.entrySize, virtualservo[i]);
+        }
+        return true;
+    }
+    return false;
+}
+
+static void copySetting(char *dst, const char *src, size_t size) {
+    memcpy(dst, src, size);
+    dst[size - 1] = '\0';
+}
+
+static void decodeLegacyHostname(const LegacyWiFiV1 &stored, WiFiConfig &config) {
+    (void)stored;
+    config.hostname[0] = '\0';  // Set to the default by loadWiFiConfig()
+}
+
+static void decodeLegacyHostname(const LegacyWiFiV2 &stored, WiFiConfig &config) {
+    copySetting(config.hostname, stored.hostname, sizeof(config.hostname));
+}
+
+// v1 (v0.4.0 - v0.4.2) and v2 (v0.4.3): the WiFiConfig struct as stored
+template <typename Legacy> static void decodeLegacyWiFi(const uint8_t *payload, WiFiConfig &config) {
+    Legacy stored;
+    memcpy(&stored, payload, sizeof(stored));
+    config.enabled = stored.enabled;
+    // v0.4.0 had AP+Station (3), now Station with AP fallback
+    config.mode = (stored.mode == 3) ? DCC_WIFI_STATION : (DccWiFiMode)stored.mode;
+    copySetting(config.stationSSID, stored.stationSSID, sizeof(config.stationSSID));
+    copySetting(config.stationPassword, stored.stationPassword, sizeof(config.stationPassword));
+    copySetting(config.apSSID, stored.apSSID, sizeof(config.apSSID));
+    copySetting(config.apPassword, stored.apPassword, sizeof(config.apPassword));
+    decodeLegacyHostname(stored, config);
+    config.useStaticIP = stored.useStaticIP;
+    config.staticIP = IPAddress(stored.staticIP.bytes[0], stored.staticIP.bytes[1], stored.staticIP.bytes[2], stored.staticIP.bytes[3]);
+    config.gateway = IPAddress(stored.gateway.bytes[0], stored.gateway.bytes[1], stored.gateway.bytes[2], stored.gateway.bytes[3]);
+    config.subnet = IPAddress(stored.subnet.bytes[0], stored.subnet.bytes[1], stored.subnet.bytes[2], stored.subnet.bytes[3]);
+    config.dns1 = IPAddress(stored.dns1.bytes[0], stored.dns1.bytes[1], stored.dns1.bytes[2], stored.dns1.bytes[3]);
+    config.dns2 = IPAddress(stored.dns2.bytes[0], stored.dns2.bytes[1], stored.dns2.bytes[2], stored.dns2.bytes[3]);
+}
+
+// v3, tagged records
+static void decodeWiFiV3(const uint8_t *payload, WiFiConfig &config) {
+    WiFiRecordV3 stored;
+    memcpy(&stored, payload, sizeof(stored));
+    config.enabled = stored.enabled;
+    config.mode = (DccWiFiMode)stored.mode;
+    copySetting(config.stationSSID, stored.stationSSID, sizeof(config.stationSSID));
+    copySetting(config.stationPassword, stored.stationPassword, sizeof(config.stationPassword));
+    copySetting(config.apSSID, stored.apSSID, sizeof(config.apSSID));
+    copySetting(config.apPassword, stored.apPassword, sizeof(config.apPassword));
+    copySetting(config.hostname, stored.hostname, sizeof(config.hostname));
+    config.useStaticIP = stored.useStaticIP;
+    config.staticIP = IPAddress(stored.staticIP[0], stored.staticIP[1], stored.staticIP[2], stored.staticIP[3]);
+    config.gateway = IPAddress(stored.gateway[0], stored.gateway[1], stored.gateway[2], stored.gateway[3]);
+    config.subnet = IPAddress(stored.subnet[0], stored.subnet[1], stored.subnet[2], stored.subnet[3]);
+    config.dns1 = IPAddress(stored.dns1[0], stored.dns1[1], stored.dns1[2], stored.dns1[3]);
+    config.dns2 = IPAddress(stored.dns2[0], stored.dns2[1], stored.dns2[2], stored.dns2[3]);
+}
+
+static bool decodeWiFi(uint8_t version, const uint8_t *payload, uint16_t length, WiFiConfig &config) {
+    if (version == 1 && length >= sizeof(LegacyWiFiV1)) {
+        decodeLegacyWiFi<LegacyWiFiV1>(payload, config);
+    } else if (version == 2 && length >= sizeof(LegacyWiFiV2)) {
+        decodeLegacyWiFi<LegacyWiFiV2>(payload, config);
+    } else if (version == WIFI_RECORD_VERSION && length >= sizeof(WiFiRecordV3)) {
+        decodeWiFiV3(payload, config);
+    } else {
+        return false;
+    }
+    return config.mode >= DCC_WIFI_OFF && config.mode <= DCC_WIFI_STATION;
+}
+
+// ---------------------------------------------------------------------------
+// Record encoders, always the current version at its fixed address
+// ---------------------------------------------------------------------------
+
+template <typename T> static void putRecord(int address, uint8_t tag, uint8_t version, const T &payload) {
+    SettingsRecordHeader header = {tag, version, sizeof(T), 0};
+    header.crc = crc32(&header, offsetof(SettingsRecordHeader, crc));
+    header.crc = crc32(&payload, sizeof(T), header.crc);
+    eepromWriter.put(address, header);
+    eepromWriter.put(address + sizeof(header), payload);
+}
+
+static void putEndRecord(int address) {
+    SettingsRecordHeader end = {SETTINGS_TAG_END, 0, 0, 0};
+    eepromWriter.put(address, end);
+}
+
+static void putServoRecords() {
+    SettingsStoreHeader store = {SETTINGS_STORE_MAGIC};
+    eepromWriter.put(0, store);
+
+    ControllerRecordV1 controller = {(int32_t)bootController.softwareVersion};
+    putRecord(SETTINGS_CONTROLLER_ADDRESS, SETTINGS_TAG_CONTROLLER, CONTROLLER_RECORD_VERSION, controller);
+
+    const DccAddressing &addressing = dccAddressIndex.getAddressing();
+    DccRecordV1 dcc = {addressing.mode, addressing.shift, addressing.boardBase};
+    putRecord(SETTINGS_DCC_ADDRESS, SETTINGS_TAG_DCC, DCC_RECORD_VERSION, dcc);
+
+    ServoRecordV2 servos[TOTAL_PINS];
+    for (int i = 0; i < TOTAL_PINS; i++) {
+        const VIRTUALSERVO &s = virtualservo[i];
+        servos[i].address = s.address;
+        servos[i].speed = s.speed;
+        servos[i].swing = s.swing;
+        servos[i].offset = s.offset;
+        servos[i].easing = s.easing;
+        servos[i].flags = (s.invert ? SERVO_RECORD_INVERT : 0) | (s.continuous ? SERVO_RECORD_CONTINUOUS : 0);
+        memcpy(servos[i].aspects, s.aspects, SERVO_ASPECT_COUNT);
+    }
+    putRecord(SETTINGS_SERVOS_ADDRESS, SETTINGS_TAG_SERVOS, SERVO_RECORD_VERSION, servos);
+}
+
+static void putWiFiRecord(const WiFiConfig &config) {
+    WiFiRecordV3 stored;
+    memset(&stored, 0, sizeof(stored));
+    stored.enabled = config.enabled;
+    stored.mode = config.mode;
+    stored.useStaticIP = config.useStaticIP;
+    copySetting(stored.stationSSID, config.stationSSID, sizeof(stored.stationSSID));
+    copySetting(stored.stationPassword, config.stationPassword, sizeof(stored.stationPassword));
+    copySetting(stored.apSSID, config.apSSID, sizeof(stored.apSSID));
+    copySetting(stored.apPassword, config.apPassword, sizeof(stored.apPassword));
+    copySetting(stored.hostname, config.hostname, sizeof(stored.hostname));
+    for (int i = 0; i < 4; i++) {
+        stored.staticIP[i] = config.staticIP[i];
+        stored.gateway[i] = config.gateway[i];
+        stored.subnet[i] = config.subnet[i];
+        stored.dns1[i] = config.dns1[i];
+        stored.dns2[i] = config.dns2[i];
+    }
+    putRecord(SETTINGS_WIFI_ADDRESS, SETTINGS_TAG_WIFI, WIFI_RECORD_VERSION, stored);
+    putEndRecord(SETTINGS_END_ADDRESS);
+}
+
+// ---------------------------------------------------------------------------
+// Loading
+// ---------------------------------------------------------------------------
+
+enum SettingsRecordStatus {
+    RECORD_OK,
+    RECORD_END,
+    RECORD_BAD     // Failed its CRC or runs off the image; nothing after it can be trusted
+};
+
+static SettingsRecordStatus readRecord(uint32_t address, SettingsRecordHeader &header, const uint8_t *&payload) {
+    const uint8_t *image = EEPROM.getDataPtr();
+    if (address + sizeof(header) > EEPROM_COMMIT_COUNT_ADDRESS) {
+        return RECORD_BAD;
+    }
+    memcpy(&header, image + address, sizeof(header));
+    if (header.tag == SETTINGS_TAG_END) {
+        return RECORD_END;
+    }
+    if (address + sizeof(header) + header.length > EEPROM_COMMIT_COUNT_ADDRESS) {
+        return RECORD_BAD;
+    }
+
+    payload = image + address + sizeof(header);
+    uint32_t crc = crc32(&header, offsetof(SettingsRecordHeader, crc));
+    crc = crc32(payload, header.length, crc);
+    return (crc == header.crc) ? RECORD_OK : RECORD_BAD;
+}
+
+/**
+ * @brief Decode the tagged records of the image
+ * @return true if every record was there, valid and in its current version
+ */
+static bool loadRecords() {
+    uint8_t found = 0;
+    bool current = true;
+    uint32_t address = sizeof(SettingsStoreHeader);
+    SettingsRecordHeader header;
+    const uint8_t *payload = nullptr;
+    SettingsRecordStatus status;
+
+    while ((status = readRecord(address, header, payload)) == RECORD_OK) {
+        bool decoded = false;
+        uint8_t currentVersion = 0;
+        switch (header.tag) {
+            case SETTINGS_TAG_CONTROLLER:
+                currentVersion = CONTROLLER_RECORD_VERSION;
+                if (header.version == CONTROLLER_RECORD_VERSION && header.length >= sizeof(ControllerRecordV1)) {
+                    ControllerRecordV1 controller;
+                    memcpy(&controller, payload, sizeof(controller));
+                    bootController.softwareVersion = controller.softwareVersion;
+                    decoded = true;
+                }
+                break;
+            case SETTINGS_TAG_SERVOS:
+                currentVersion = SERVO_RECORD_VERSION;
+                decoded = decodeServos(header.version, payload, header.length);
+                break;
+            case SETTINGS_TAG_WIFI:
+                currentVersion = WIFI_RECORD_VERSION;
+                decoded = storedWiFiValid = decodeWiFi(header.version, payload, header.length, storedWiFi);
+                break;
+            case SETTINGS_TAG_DCC:
+                currentVersion = DCC_RECORD_VERSION;
+                if (header.version == DCC_RECORD_VERSION && header.length >= sizeof(DccRecordV1)) {
+                    DccRecordV1 dcc;
+                    memcpy(&dcc, payload, sizeof(dcc));
+                    DccAddressing addressing;
+                    addressing.mode = dcc.mode;
+                    addressing.shift = dcc.shift;
+                    addressing.boardBase = dcc.boardBase;
+                    decoded = dccAddressIndex.configure(addressing);
+                }
+                break;
+        }
+
+        if (decoded) {
+            found |= 1 << header.tag;
+        } else {
+            Serial.printf("Settings record %u version %u not understood, skipped\n", header.tag, header.version);
+        }
+        if (!decoded || header.version != currentVersion) {
+            current = false;
+        }
+        address += sizeof(header) + header.length;
+    }
+
+    if (status == RECORD_BAD) {
+        Serial.printf("Settings record at %lu is damaged, defaults used from there on\n", (unsigned long)address);
+        current = false;
+    }
+    return current && found == ((1 << SETTINGS_TAG_CONTROLLER) | (1 << SETTINGS_TAG_SERVOS) | (1 << SETTINGS_TAG_WIFI) |
+                                (1 << SETTINGS_TAG_DCC));
+}
+
+/**
+ * @brief Decode an untagged image written before v0.5.0
+ * @return false if the version is not a known layout
+ */
+static bool loadLegacyLayout(int32_t version) {
+    if (version < LEGACY_LAYOUT_V4_FIRST || version > LEGACY_LAYOUT_V4_LAST) {
+        return false;
+    }
+    uint8_t wifiVersion = (version >= LEGACY_LAYOUT_V4_HOSTNAME) ? 2 : 1;
+
+    const uint8_t *image = EEPROM.getDataPtr();
+    decodeServos(1, image + LEGACY_SERVOS_ADDRESS, sizeof(LegacyServoV4) * TOTAL_PINS);
+    storedWiFiValid = decodeWiFi(wifiVersion, image + LEGACY_WIFI_ADDRESS,
+                                 (wifiVersion == 1) ? sizeof(LegacyWiFiV1) : sizeof(LegacyWiFiV2), storedWiFi);
+    return true;
+}
+
 void initializeEEPROM() {
     // Initialize EEPROM with specified size (ESP32 compatible)
     EEPROM.begin(EEPROM_SIZE);
+
+    // Settings live in the journal partition when there is one; on its first
+    // boot the journal takes over whatever EEPROM held
+    if (configJournal.begin(CONFIG_JOURNAL_PARTITION, EEPROM.getDataPtr(), EEPROM_SIZE)) {
+        Serial.printf("Config journal: sector %u of %u, %lu bytes used\n",
+                      configJournal.getLiveSector(), configJournal.getSectorCount(),
+                      (unsigned long)configJournal.getUsedBytes());
+    } else {
+        Serial.println("Config journal: no partition, using EEPROM commits");
+    }
+    eepromWriter.begin();
 }
 
 void getSettings() {
-    int eeAddr = 0;
-    EEPROM.get(eeAddr, bootController);
-    
-    if (m_defaultController.softwareVersion != bootController.softwareVersion) {
-        // If software version has changed, we need to re-initialize EEPROM with factory defaults
+    SettingsStoreHeader store = {0};
+    LegacyController legacy = {};
+    EEPROM.get(0, store);
+    EEPROM.get(0, legacy);
+
+    // Start from defaults: whatever the image does not hold keeps them
+    bootController = m_defaultController;
+    for (auto &s : virtualservo) {
+        setDefaultServoSettings(s);
+    }
+    dccAddressIndex.configure(DccAddressing());
+    storedWiFiValid = false;
+
+    bool current = false;
+    if (store.magic == SETTINGS_STORE_MAGIC) {
+        current = loadRecords();
+        if (current && bootController.softwareVersion != NUMERIC_VERSION) {
+            Serial.printf("Settings written by version %ld\n", bootController.softwareVersion);
+            current = false;
+        }
+    } else if (loadLegacyLayout(legacy.softwareVersion)) {
+        Serial.printf("Migrated settings from version %ld\n", (long)legacy.softwareVersion);
+    } else {
+        // Erased, or a layout from before v0.4.0
         Serial.println("Restoring factory defaults");
-        EEPROM.put(0, m_defaultController);
-        eeAddr += sizeof(m_defaultController);
-        
-        // Use valid ESP32 servo pins from pwmPins array. Set defaults
-        int i = 0;
-        for (auto &s : virtualservo) {
-            s.pin = pwmPins[i];  // Use actual valid servo pins
-            s.address = 0;  // Default to no DCC address assigned
-            s.invert = 0;
-            s.position = 90;
-            s.swing = 25;
-            s.offset = 0;  // Default offset
-            s.speed = SPEED_NORMAL;  // Default to normal speed
-            s.continuous = 0;
-            s.state = SERVO_BOOT;
-            ++i;
+    }
+
+    if (!current) {
+        // Write everything back in the current layout
+        bootController.softwareVersion = NUMERIC_VERSION;
+        putServoRecords();
+        if (storedWiFiValid) {
+            putWiFiRecord(storedWiFi);
+        } else {
+            putEndRecord(SETTINGS_WIFI_ADDRESS);  // loadWiFiConfig() saves the defaults
         }
-        
-        // Write back default values
-        EEPROM.put(eeAddr, virtualservo);
-        EEPROM.commit(); // ESP32 specific - commit changes to flash
+        eepromWriter.flush();
     }
 
-    // Either way, now populate our structs with EEPROM values
-    eeAddr = 0;
-    EEPROM.get(eeAddr, bootController);
-    eeAddr += sizeof(bootController);
-    EEPROM.get(eeAddr, virtualservo);
-    
     // Initialize the pin assignments and servo drivers
     int i = 0;
     
@@ -63,136 +403,89 @@ void getSettings() {
         if ((s.offset < -SERVO_MAX_OFFSET) || (s.offset > SERVO_MAX_OFFSET)) s.offset = 0;
         
         // Ensure speed is valid
-        if (s.speed > SPEED_SLOW) s.speed = SPEED_NORMAL;
+        if (s.speed > SERVO_MAX_SPEED_DPS) s.speed = SERVO_SPEED_NORMAL_DPS;
+        if (s.easing >= EASING_COUNT) s.easing = EASING_LINEAR;
+        for (uint8_t &aspect : s.aspects) {
+            if (aspect > 100) aspect = SERVO_ASPECT_UNUSED;
+        }
         
         // Calculate closed position (we may be inverted) then back off 5 degrees and set that as position
         uint8_t centerPosition = 90 + s.offset;  // Apply offset to center position
         if (s.invert) {
             // Max position
-            s.position = centerPosition + s.swing - 5;
+            setServoPosition(s, centerPosition + s.swing - 5);
         } else {
             // Min position, normal for closed
-            s.position = centerPosition - s.swing + 5;
+            setServoPosition(s, centerPosition - s.swing + 5);
         }
 
         // Initialize the servo driver
         servoDriver[i].detach();  // Don't attach at this time as it will assert an unhelpful position
         s.thisDriver = &servoDriver[i];
+        servoOutput.bind(i, s.thisDriver);
         ++i;
     }
     
+    refreshServoConfig();
+    
     Serial.print("\nSoftware version: ");
     Serial.print(bootController.softwareVersion, DEC);
     Serial.println("\n...............\n");
 }
 
 void putSettings() {
-    int eeAddr = 0;
     if (bootController.isDirty == false) { 
         return; 
     }
     
-    EEPROM.put(eeAddr, bootController);
-    eeAddr += sizeof(bootController);
-    EEPROM.put(eeAddr, virtualservo);
-    EEPROM.commit(); // ESP32 specific - commit changes to flash
+    // Committed by eepromWriter once the settings stop changing
+    putServoRecords();
     
-    Serial.println("Settings saved to EEPROM");
     bootController.isDirty = false;
 }
 
+void flushSettings() {
+    eepromWriter.flush();
+}
+
 void saveWiFiConfig() {
-    // WiFi config is stored after controller and servo data
-    int eeAddr = sizeof(bootController) + sizeof(virtualservo);
-    
     // Debug: Show what we're about to save
     Serial.printf("Saving to EEPROM - Mode: %d, Enabled: %s\n", wifiConfig.mode, wifiConfig.enabled ? "true" : "false");
     Serial.printf("Saving Station SSID: '%s'\n", wifiConfig.stationSSID);
     Serial.printf("Saving Station Password: '%s'\n", wifiConfig.stationPassword);
     Serial.printf("Saving AP SSID: '%s'\n", wifiConfig.apSSID);
-    Serial.printf("EEPROM address: %d\n", eeAddr);
+    Serial.printf("EEPROM address: %u\n", (unsigned)SETTINGS_WIFI_ADDRESS);
     
-    EEPROM.put(eeAddr, wifiConfig);
-    EEPROM.commit(); // ESP32 specific - commit changes to flash
-    Serial.println("✅ WiFi configuration saved to EEPROM and committed");
+    // Committed at once, with any servo settings still pending: WiFi changes
+    // are usually followed by a reconnect or a restart
+    putWiFiRecord(wifiConfig);
+    eepromWriter.flush();
+    if (eepromWriter.isPending()) {
+        Serial.println("✗ WiFi configuration not committed (flash write failed, will retry)");
+    } else {
+        Serial.println("✅ WiFi configuration saved to EEPROM and committed");
+    }
 }
 
-void loadWiFiConfig() {
-    // WiFi config is stored after controller and servo data
-    int eeAddr = sizeof(bootController) + sizeof(virtualservo);
-    
-    Serial.printf("DEBUG: WiFiConfig structure size: %d bytes\n", sizeof(WiFiConfig));
-    Serial.printf("DEBUG: Loading WiFi config from EEPROM address: %d\n", eeAddr);
-    
-    // Create a temporary structure to validate loaded data
-    WiFiConfig tempConfig;
-    EEPROM.get(eeAddr, tempConfig);
-    
-    // Debug: Show what was loaded from EEPROM
-    Serial.printf("Loaded from EEPROM - Mode: %d, Enabled: %s\n", tempConfig.mode, tempConfig.enabled ? "true" : "false");
-    Serial.printf("Loaded Station SSID: '%s'\n", tempConfig.stationSSID);
-    Serial.printf("Loaded Station Password: '%s'\n", tempConfig.stationPassword);
-    Serial.printf("Loaded AP SSID: '%s'\n", tempConfig.apSSID);
-    
-    // Check if the loaded config appears to be valid
-    // After adding hostname field, old configs may be corrupted, so be more strict
-    bool configValid = (tempConfig.mode >= DCC_WIFI_OFF && tempConfig.mode <= DCC_WIFI_STATION);
-    
-    // Additional validation: check if SSID contains reasonable characters
-    bool ssidValid = true;
-    for (int i = 0; i < WIFI_SSID_MAX_LENGTH && tempConfig.apSSID[i] != '\0'; i++) {
-        if (tempConfig.apSSID[i] < 32 || tempConfig.apSSID[i] > 126) {
-            ssidValid = false;
-            break;
-        }
-    }
-    
-    // Check for corrupted IP addresses (DNS servers appearing in wrong fields)
-    bool ipValid = true;
-    uint32_t staticIPValue = (uint32_t)tempConfig.staticIP;
-    uint32_t gatewayValue = (uint32_t)tempConfig.gateway;
-    
-    // Detect if DNS servers (8.8.8.8 or 8.8.4.4) are in static IP or gateway fields
-    // This indicates structure corruption from the hostname field addition
-    if (staticIPValue == IPAddress(8, 8, 4, 4) || staticIPValue == IPAddress(8, 8, 8, 8) ||
-        gatewayValue == IPAddress(8, 8, 4, 4) || gatewayValue == IPAddress(8, 8, 8, 8)) {
-        Serial.println("⚠ CORRUPTION DETECTED: DNS servers found in IP config fields");
-        Serial.printf("Static IP: %s, Gateway: %s\n", 
-                      tempConfig.staticIP.toString().c_str(), tempConfig.gateway.toString().c_str());
-        ipValid = false;
-    }
-    
-    // Check hostname field for corruption
-    bool hostnameValid = true;
-    if (strlen(tempConfig.hostname) > 0) {
-        for (int i = 0; i < strlen(tempConfig.hostname) && i < WIFI_HOSTNAME_MAX_LENGTH; i++) {
-            char c = tempConfig.hostname[i];
-            if (c < 32 || c > 126) {
-                hostnameValid = false;
-                break;
-            }
+bool readStoredWiFiConfig(WiFiConfig &config) {
+    uint32_t address = sizeof(SettingsStoreHeader);
+    SettingsRecordHeader header;
+    const uint8_t *payload = nullptr;
+
+    while (readRecord(address, header, payload) == RECORD_OK) {
+        if (header.tag == SETTINGS_TAG_WIFI) {
+            return decodeWiFi(header.version, payload, header.length, config);
         }
+        address += sizeof(header) + header.length;
     }
-    
-    // Overall validation - all checks must pass
-    configValid = configValid && ssidValid && ipValid && hostnameValid;
-    
-    // Check for completely garbage data (common after structure changes)
-    if (!ssidValid || strlen(tempConfig.apSSID) == 0 || !ipValid) {
-        Serial.println("WiFi config appears corrupted (likely due to structure change), forcing reset");
-        configValid = false;
-    }
-    
-    Serial.printf("Config validation: mode=%s, SSID=%s, IP=%s, hostname=%s, overall=%s\n", 
-                  (tempConfig.mode >= DCC_WIFI_OFF && tempConfig.mode <= DCC_WIFI_STATION) ? "OK" : "BAD",
-                  ssidValid ? "OK" : "BAD", 
-                  ipValid ? "OK" : "BAD",
-                  hostnameValid ? "OK" : "BAD",
-                  configValid ? "VALID" : "INVALID");
-    
-    if (configValid && strlen(tempConfig.apSSID) > 0) {
-        // Config appears valid, use it
-        wifiConfig = tempConfig;
+    return false;
+}
+
+void loadWiFiConfig() {
+    // The record was checked against its CRC by getSettings(); only an
+    // uninitialized AP SSID is left to catch here
+    if (storedWiFiValid && strlen(storedWiFi.apSSID) > 0) {
+        wifiConfig = storedWiFi;
         
         // Ensure hostname is set (for backward compatibility with older configs)
         if (strlen(wifiConfig.hostname) == 0) {
@@ -216,18 +509,12 @@ void loadWiFiConfig() {
         strncpy(wifiConfig.hostname, "dccservo", WIFI_HOSTNAME_MAX_LENGTH - 1);
         wifiConfig.hostname[WIFI_HOSTNAME_MAX_LENGTH - 1] = '\0';
         wifiConfig.useStaticIP = false;
-        
-        // Reset all IP fields to proper defaults (not corrupted DNS addresses)
         wifiConfig.staticIP = IPAddress(192, 168, 1, 100);
         wifiConfig.gateway = IPAddress(192, 168, 1, 1);
         wifiConfig.subnet = IPAddress(255, 255, 255, 0);
         wifiConfig.dns1 = IPAddress(8, 8, 8, 8);
         wifiConfig.dns2 = IPAddress(8, 8, 4, 4);
         
-        Serial.printf("Reset to defaults - Hostname: %s\n", wifiConfig.hostname);
-        Serial.printf("Reset to defaults - Static IP: %s, Gateway: %s\n", 
-                      wifiConfig.staticIP.toString().c_str(), wifiConfig.gateway.toString().c_str());
-        
         // Generate default AP credentials
         generateDefaultCredentials();
         
@@ -244,16 +531,23 @@ void factoryResetAll() {
     bootController.isDirty = true;
     
     // Reset all servos to factory defaults: servo,addr,swing,offset,speed,invert,continuous = 0,0,25,0,0,0
-    for (int i = 0; i < TOTAL_PINS; i++) {
-        virtualservo[i].pin = pwmPins[i];
-        virtualservo[i].address = 0;
-        virtualservo[i].swing = 25;
-        virtualservo[i].offset = 0;
-        virtualservo[i].speed = 0;  // Instant
-        virtualservo[i].invert = false;
-        virtualservo[i].continuous = false;
-        virtualservo[i].position = 90;  // Center position
-        virtualservo[i].state = SERVO_BOOT;
+    {
+        ServoConfigLock lock;
+        for (int i = 0; i < TOTAL_PINS; i++) {
+            virtualservo[i].pin = pwmPins[i];
+            virtualservo[i].address = 0;
+            virtualservo[i].swing = 25;
+            virtualservo[i].offset = 0;
+            virtualservo[i].speed = 0;  // Instant
+            virtualservo[i].easing = EASING_LINEAR;
+            virtualservo[i].invert = false;
+            virtualservo[i].continuous = false;
+            setDefaultServoAspects(virtualservo[i].aspects);
+            setServoPosition(virtualservo[i], SERVO_CENTER_POSITION);  // Center position
+            virtualservo[i].state = SERVO_BOOT;
+        }
+        dccAddressIndex.configure(DccAddressing());
+        refreshServoConfig();
     }
     
     // Reset WiFi configuration to defaults
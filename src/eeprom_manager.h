@@ -11,11 +11,11 @@ struct WiFiConfig;
 // Note: Using the NUMERIC_VERSION from version.h for consistency
 // Format: MAJOR*100 + MINOR*10 + PATCH (to maintain compatibility with existing EEPROM data)
 
-// Controller structure for EEPROM storage
+// Controller state; stored as the controller record (settings_layouts.h)
 struct CONTROLLER {
-    long softwareVersion = NUMERIC_VERSION;  // Numeric version for comparison
+    long softwareVersion = NUMERIC_VERSION;  // Version that wrote the settings, current once loaded
     bool isDirty = false;  // Will be true if EEPROM needs a write
-    long long padding;     // Fixes a bug on some platforms where EEPROM contents corrupt on readback
+    long long padding;     // Part of the untagged layout before v0.5.0, no longer stored
 };
 
 // Global controller objects
@@ -26,8 +26,16 @@ extern CONTROLLER m_defaultController;
 void initializeEEPROM();
 void getSettings();
 void putSettings();
+void flushSettings();
 void saveWiFiConfig();
 void loadWiFiConfig();
+
+/**
+ * @brief Read the WiFi settings as stored, without applying them
+ * @param config Filled in from the WiFi record
+ * @return false if there is no valid WiFi record
+ */
+bool readStoredWiFiConfig(WiFiConfig &config);
 void factoryResetAll();
 
 #endif // EEPROM_MANAGER_H
@@ -0,0 +1,217 @@
+#include "event_socket.h"
+#include "servo_controller.h"
+#include "core/event_bus.h"
+#include "core/servo_task.h"
+#include "core/servo_command_queue.h"
+#include "core/servo_move_scheduler.h"
+#include <WebSocketsServer.h>
+#include <ArduinoJson.h>
+
+/*
+ * WebSocket push channel on EVENT_SOCKET_PORT.
+ *
+ * Clients choose topics with a text frame:
+ *   {"subscribe":["servo","dcc","health"]}   {"unsubscribe":["dcc"]}
+ * and receive JSON text frames:
+ *   {"servos":[[state,position],...]}                  on subscribing to "servo"
+ *   {"lost":n,"ev":[["s",ms,servo,state],["d",ms,addr,dir],...]}
+ *   {"health":{...}}                                   every EVENT_SOCKET_HEALTH_MS
+ *
+ * Each client reads the event bus through its own cursor, at most one frame
+ * of EVENT_SOCKET_BATCH events per EVENT_SOCKET_SEND_MS. A client that cannot
+ * keep up falls behind the ring and loses the oldest events ("lost"), so a
+ * slow browser never delays the others or the servo engine.
+ */
+
+struct EventSocketClient {
+    bool connected;
+    uint8_t topics;         // BUS_TOPIC_* bits
+    uint32_t cursor;        // Next event bus sequence to send
+    uint32_t lost;          // Events dropped since the last frame
+    uint32_t lastSendMs;
+    uint32_t lastHealthMs;
+};
+
+static WebSocketsServer eventSocket(EVENT_SOCKET_PORT);
+static EventSocketClient clients[WEBSOCKETS_SERVER_CLIENT_MAX];
+static bool eventSocketStarted = false;
+
+static uint8_t parseTopics(JsonVariantConst list) {
+    uint8_t topics = 0;
+    for (JsonVariantConst topic : list.as<JsonArrayConst>()) {
+        const char *name = topic.as<const char *>();
+        if (name == nullptr) continue;
+        if (strcmp(name, "servo") == 0) topics |= BUS_TOPIC_SERVO;
+        else if (strcmp(name, "dcc") == 0) topics |= BUS_TOPIC_DCC;
+        else if (strcmp(name, "health") == 0) topics |= BUS_TOPIC_HEALTH;
+    }
+    return topics;
+}
+
+// Current state of every servo, so a new subscriber starts in sync
+static void sendServoSnapshot(uint8_t num) {
+    char frame[16 + TOTAL_PINS * 10];
+    size_t len = snprintf(frame, sizeof(frame), "{\"servos\":[");
+    for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+        len += snprintf(frame + len, sizeof(frame) - len, "%s[%u,%u]", i ? "," : "",
+                        virtualservo[i].state, virtualservo[i].position);
+    }
+    len += snprintf(frame + len, sizeof(frame) - len, "]}");
+    eventSocket.sendTXT(num, frame, len);
+}
+
+static void sendHealth(uint8_t num, EventSocketClient &client) {
+    char frame[320];
+    size_t len = snprintf(frame, sizeof(frame),
+        "{\"health\":{\"uptimeMs\":%lu,\"freeHeap\":%lu,\"minFreeHeap\":%lu,\"ticks\":%lu,\"lateTicks\":%lu,"
+        "\"maxRunUs\":%lu,\"activeServos\":%u,\"movesActive\":%u,\"movesQueued\":%u,\"queueDropped\":%lu,"
+        "\"clients\":%u}}",
+        (unsigned long)millis(), (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMinFreeHeap(),
+        (unsigned long)servoTask.getTickCount(), (unsigned long)servoTask.getLateTicks(),
+        (unsigned long)servoTask.getMaxRunUs(), getActiveServoMask(), servoMoveScheduler.getMovingCount(),
+        servoMoveScheduler.getWaitingCount(), (unsigned long)servoCommandQueue.getDroppedCount(),
+        getEventSocketClientCount());
+    eventSocket.sendTXT(num, frame, len);
+    client.lastHealthMs = millis();
+}
+
+// Event type as sent to clients: servo state, DCC turnout command, DCC signal aspect
+static char getEventTypeCode(uint8_t type) {
+    switch (type) {
+        case BUS_EVENT_SERVO_STATE: return 's';
+        case BUS_EVENT_DCC_ASPECT: return 'a';
+        default: return 'd';
+    }
+}
+
+// Send the next batch of subscribed events, if any
+static void sendEvents(uint8_t num, EventSocketClient &client, uint32_t first, uint32_t next) {
+    // Fell behind the ring: skip to the oldest event still held
+    if ((int32_t)(first - client.cursor) > 0) {
+        client.lost += first - client.cursor;
+        client.cursor = first;
+    }
+    
+    char frame[48 + EVENT_SOCKET_BATCH * 32];
+    size_t len = 0;
+    uint8_t count = 0;
+    BusEvent event;
+    
+    while ((client.cursor != next) && (count < EVENT_SOCKET_BATCH)) {
+        if (!eventBus.get(client.cursor, event)) {
+            // Overwritten while we were reading
+            client.lost++;
+            client.cursor++;
+            continue;
+        }
+        client.cursor++;
+        if (!(client.topics & EventBus::getTopic(event.type))) continue;
+        
+        if (count == 0) {
+            len = snprintf(frame, sizeof(frame), "{\"lost\":%lu,\"ev\":[", (unsigned long)client.lost);
+        }
+        len += snprintf(frame + len, sizeof(frame) - len, "%s[\"%c\",%lu,%u,%u]", count ? "," : "",
+                        getEventTypeCode(event.type), (unsigned long)event.timestamp,
+                        event.id, event.value);
+        count++;
+    }
+    
+    if (count == 0) return;
+    len += snprintf(frame + len, sizeof(frame) - len, "]}");
+    
+    // A failed send loses the batch rather than retrying into a stalled socket
+    if (eventSocket.sendTXT(num, frame, len)) {
+        client.lost = 0;
+    } else {
+        client.lost += count;
+    }
+    client.lastSendMs = millis();
+}
+
+static void onEventSocket(uint8_t num, WStype_t type, uint8_t *payload, size_t length) {
+    if (num >= WEBSOCKETS_SERVER_CLIENT_MAX) return;
+    EventSocketClient &client = clients[num];
+    
+    switch (type) {
+    case WStype_CONNECTED:
+        client = {true, 0, eventBus.getNextSequence(), 0, 0, 0};
+        break;
+        
+    case WStype_DISCONNECTED:
+        client.connected = false;
+        client.topics = 0;
+        break;
+        
+    case WStype_TEXT: {
+        StaticJsonDocument<256> doc;
+        if (deserializeJson(doc, payload, length)) {
+            eventSocket.sendTXT(num, "{\"error\":\"bad request\"}");
+            break;
+        }
+        
+        uint8_t added = parseTopics(doc["subscribe"]);
+        client.topics = (client.topics | added) & ~parseTopics(doc["unsubscribe"]);
+        
+        if (added & (BUS_TOPIC_SERVO | BUS_TOPIC_DCC)) {
+            // Start from now; history before the subscription is not replayed
+            client.cursor = eventBus.getNextSequence();
+            client.lost = 0;
+        }
+        if (added & BUS_TOPIC_SERVO) {
+            sendServoSnapshot(num);
+        }
+        if (added & BUS_TOPIC_HEALTH) {
+            sendHealth(num, client);
+        }
+        break;
+    }
+        
+    default:
+        break;
+    }
+}
+
+void startEventSocket() {
+    // initializeWiFi() runs again after a WiFi config change
+    if (eventSocketStarted) return;
+    eventSocketStarted = true;
+    
+    for (auto &client : clients) {
+        client.connected = false;
+    }
+    eventSocket.begin();
+    eventSocket.onEvent(onEventSocket);
+    Serial.printf("Event socket started on port %d\n", EVENT_SOCKET_PORT);
+}
+
+void handleEventSocket() {
+    if (!eventSocketStarted) return;
+    eventSocket.loop();
+    
+    uint32_t first = eventBus.getFirstSequence();
+    uint32_t next = eventBus.getNextSequence();
+    uint32_t now = millis();
+    
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) {
+        EventSocketClient &client = clients[num];
+        if (!client.connected) continue;
+        
+        if (!(client.topics & (BUS_TOPIC_SERVO | BUS_TOPIC_DCC))) {
+            client.cursor = next;
+        } else if ((client.cursor != next) && (now - client.lastSendMs >= EVENT_SOCKET_SEND_MS)) {
+            sendEvents(num, client, first, next);
+        }
+        
+        if ((client.topics & BUS_TOPIC_HEALTH) && (now - client.lastHealthMs >= EVENT_SOCKET_HEALTH_MS)) {
+            sendHealth(num, client);
+        }
+    }
+}
+
+uint8_t getEventSocketClientCount() {
+    uint8_t count = 0;
+    for (const auto &client : clients) {
+        if (client.connected) count++;
+    }
+    return count;
+}
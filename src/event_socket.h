@@ -0,0 +1,11 @@
+#ifndef EVENT_SOCKET_H
+#define EVENT_SOCKET_H
+
+#include "config.h"
+
+// Function declarations
+void startEventSocket();
+void handleEventSocket();
+uint8_t getEventSocketClientCount();
+
+#endif // EVENT_SOCKET_H
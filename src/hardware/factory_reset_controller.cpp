@@ -1,4 +1,5 @@
 #include "factory_reset_controller.h"
+#include "../eeprom_manager.h"
 
 FactoryResetController::FactoryResetController(uint8_t pin, unsigned long holdTimeMs)
     : buttonPin(pin)
@@ -71,6 +72,7 @@ void FactoryResetController::performFactoryReset() {
     Serial.println("🔄 Rebooting now...");
     delay(500);
     
-    // Restart the ESP32
+    // Restart the ESP32, without losing settings still waiting for a commit
+    flushSettings();
     ESP.restart();
 }
@@ -1,5 +1,6 @@
 #include "led_controller.h"
 #include "../config.h"
+#include "../utils/diag_log.h"
 
 LedController::LedController(uint8_t pin) 
     : ledPin(pin)
@@ -15,7 +16,7 @@ void LedController::begin() {
     digitalWrite(ledPin, LOW);
     isInitialized = true;
     
-    Serial.printf("LED Controller initialized on GPIO pin %d\n", ledPin);
+    DIAG_INFO("LED Controller initialized on GPIO pin %d", ledPin);
     
     // Test LED during initialization
     testLed();
@@ -43,7 +44,7 @@ void LedController::triggerDccSignal() {
     dccSignalActive = true;
     digitalWrite(ledPin, HIGH);
     
-    Serial.println("DCC signal LED triggered");
+    DIAG_DEBUG("DCC signal LED triggered");
 }
 
 void LedController::updateDccSignal() {
@@ -52,7 +53,7 @@ void LedController::updateDccSignal() {
     unsigned long currentMs = millis();
     if (currentMs - dccSignalStartMs >= DCC_SIGNAL_DURATION) {
         dccSignalActive = false;
-        Serial.println("DCC signal LED ended, restoring heartbeat state");
+        DIAG_DEBUG("DCC signal LED ended, restoring heartbeat state");
         
         // Restore heartbeat state when DCC signal ends
         digitalWrite(ledPin, heartbeatState ? HIGH : LOW);
@@ -73,7 +74,7 @@ void LedController::rapidBlink(int count, int delayMs) {
 void LedController::testLed() {
     if (!isInitialized) return;
     
-    Serial.println("Testing LED functionality...");
+    DIAG_INFO("Testing LED functionality...");
     rapidBlink(3, 200);
-    Serial.println("LED test completed");
+    DIAG_INFO("LED test completed");
 }
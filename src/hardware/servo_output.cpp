@@ -0,0 +1,99 @@
+#include "servo_output.h"
+
+// Global instance
+ServoOutput servoOutput;
+
+ServoOutput::ServoOutput()
+    : attachRequested(0)
+    , attachedMask(0)
+    , dirtyMask(0) {
+    for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+        drivers[i] = nullptr;
+        pins[i] = 0;
+        requestedUs[i] = 0;
+        committedUs[i] = 0;
+    }
+    resetStats();
+}
+
+void ServoOutput::bind(uint8_t channel, Servo *driver) {
+    if (channel >= TOTAL_PINS) return;
+    
+    uint16_t bit = 1U << channel;
+    drivers[channel] = driver;
+    committedUs[channel] = 0;
+    attachRequested &= ~bit;
+    attachedMask &= ~bit;
+    dirtyMask &= ~bit;
+}
+
+void ServoOutput::attach(uint8_t channel, uint8_t pin) {
+    if (channel >= TOTAL_PINS) return;
+    
+    pins[channel] = pin;
+    attachRequested |= 1U << channel;
+    dirtyMask |= 1U << channel;
+}
+
+void ServoOutput::detach(uint8_t channel) {
+    if (channel >= TOTAL_PINS) return;
+    
+    attachRequested &= ~(1U << channel);
+    dirtyMask |= 1U << channel;
+}
+
+void ServoOutput::writeMicroseconds(uint8_t channel, uint16_t us) {
+    if (channel >= TOTAL_PINS) return;
+    
+    requestedWrites++;
+    requestedUs[channel] = us;
+    if (us != committedUs[channel]) {
+        dirtyMask |= 1U << channel;
+    }
+}
+
+void ServoOutput::commit() {
+    uint16_t pending = dirtyMask;
+    dirtyMask = 0;
+    
+    while (pending) {
+        uint8_t channel = __builtin_ctz(pending);
+        uint16_t bit = 1U << channel;
+        pending &= pending - 1;
+        
+        Servo *driver = drivers[channel];
+        if (driver == nullptr) continue;
+        
+        bool wanted = attachRequested & bit;
+        bool isAttached = attachedMask & bit;
+        
+        if (!wanted) {
+            if (isAttached) {
+                driver->detach();
+                attachedMask &= ~bit;
+                detachCount++;
+            }
+            committedUs[channel] = 0;  // Rewrite on the next attach
+            continue;
+        }
+        
+        if (!isAttached) {
+            driver->attach(pins[channel]);
+            attachedMask |= bit;
+            attachCount++;
+        }
+        
+        if (requestedUs[channel] != 0 && requestedUs[channel] != committedUs[channel]) {
+            driver->writeMicroseconds(requestedUs[channel]);
+            committedUs[channel] = requestedUs[channel];
+            issuedWrites++;
+        }
+    }
+}
+
+void ServoOutput::resetStats() {
+    requestedWrites = 0;
+    issuedWrites = 0;
+    attachCount = 0;
+    detachCount = 0;
+}
@@ -0,0 +1,93 @@
+#ifndef SERVO_OUTPUT_H
+#define SERVO_OUTPUT_H
+
+#include <Arduino.h>
+#include <ESP32Servo.h>
+#include "../config.h"
+
+/**
+ * @brief Write-coalescing output stage between the motion engine and the servo drivers
+ * 
+ * The motion engine calls attach/detach/writeMicroseconds per channel exactly as
+ * it would on a Servo. Requests are only recorded; commit() applies them in one
+ * batch at the end of the tick, touching only channels whose attach state or
+ * pulse width actually changed since the last commit. Repeated identical pulse
+ * widths never reach ESP32Servo or the LEDC registers.
+ */
+class ServoOutput {
+private:
+    Servo *drivers[TOTAL_PINS];
+    uint8_t pins[TOTAL_PINS];
+    uint16_t requestedUs[TOTAL_PINS];
+    uint16_t committedUs[TOTAL_PINS];   // 0 = nothing written since attach
+    uint16_t attachRequested;           // Bitmask of channels that should be attached
+    uint16_t attachedMask;              // Bitmask of channels attached in hardware
+    uint16_t dirtyMask;                 // Channels with uncommitted changes
+    
+    // Statistics
+    uint32_t requestedWrites;
+    uint32_t issuedWrites;
+    uint32_t attachCount;
+    uint32_t detachCount;
+
+public:
+    /**
+     * @brief Construct an output stage with no drivers bound
+     */
+    ServoOutput();
+
+    /**
+     * @brief Bind a servo driver to a channel
+     * @param channel Servo slot (0 to TOTAL_PINS-1)
+     * @param driver Driver for the slot (currently detached)
+     */
+    void bind(uint8_t channel, Servo *driver);
+
+    /**
+     * @brief Request a channel be attached to a pin
+     * @param channel Servo slot
+     * @param pin GPIO pin
+     */
+    void attach(uint8_t channel, uint8_t pin);
+
+    /**
+     * @brief Request a channel be detached
+     * @param channel Servo slot
+     */
+    void detach(uint8_t channel);
+
+    /**
+     * @brief Check the requested attach state of a channel
+     * @param channel Servo slot
+     * @return true if attach() is in effect (committed or not)
+     */
+    bool attached(uint8_t channel) const { return attachRequested & (1U << channel); }
+
+    /**
+     * @brief Request a pulse width on a channel
+     * @param channel Servo slot
+     * @param us Pulse width in microseconds
+     */
+    void writeMicroseconds(uint8_t channel, uint16_t us);
+
+    /**
+     * @brief Apply all pending changes to the drivers (once per tick)
+     */
+    void commit();
+
+    uint32_t getRequestedWrites() const { return requestedWrites; }
+    uint32_t getIssuedWrites() const { return issuedWrites; }
+    uint32_t getSuppressedWrites() const { return requestedWrites - issuedWrites; }
+    uint32_t getAttachCount() const { return attachCount; }
+    uint32_t getDetachCount() const { return detachCount; }
+
+    /**
+     * @brief Clear the write counters
+     */
+    void resetStats();
+};
+
+// Global instance
+extern ServoOutput servoOutput;
+
+#endif // SERVO_OUTPUT_H
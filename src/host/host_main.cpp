@@ -0,0 +1,1383 @@
+#include "host_runtime.h"
+#include "../config.h"
+#include "../servo_controller.h"
+#include "../dcc_handler.h"
+#include "../eeprom_manager.h"
+#include "../settings_layouts.h"
+#include "../serial_commands.h"
+#include "../wifi_controller.h"
+#include "../web_pages.h"
+#include "../web_assets.h"
+#include "../utils/dcc_debug_logger.h"
+#include "../utils/servo_easing.h"
+#include "../utils/eeprom_writer.h"
+#include "../utils/config_journal.h"
+#include "../utils/servo_state_log.h"
+#include "../utils/diag_log.h"
+#include "../utils/dcc_capture.h"
+#include "../utils/dcc_repeat_filter.h"
+#include "../utils/dcc_address_index.h"
+#include "../core/servo_task.h"
+#include "../core/servo_command_queue.h"
+#include "../core/servo_move_scheduler.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/*
+ * Host harness for the native environment.
+ *
+ *   program            Boot, then read serial command lines from stdin.
+ *                      Lines starting with '@' drive the harness instead:
+ *                        @dcc addr,dir   decode an accessory packet
+ *                        @aspect addr,n  decode an extended accessory (signal aspect) packet
+ *                        @capture file   save the /dcc-capture download to a file
+ *                        @wait ms        run the firmware for ms of virtual time
+ *                        @time           print the virtual clock
+ *                        @heap           print heap usage
+ *                        @page path      print a web page (/, /config, /api/v1/servos, ...);
+ *                                        /servo and the other static pages
+ *                                        come out gzipped, as served
+ *   program bench [motion|dispatch|heap|pages|diag|repeats|addressing|aspects|journal|layouts]
+ *                      Boot and run the benchmarks (all by default).
+ *   program replay file
+ *                      Boot from the settings in a /dcc-capture download and
+ *                      feed its packets to the decoder at their captured times.
+ *
+ * The firmware runs on the virtual clock in host_runtime.h: the servo task
+ * ticks every SERVO_UPDATE_INTERVAL and loop() work runs every millisecond.
+ */
+
+#define HOST_LOOP_INTERVAL_US 1000UL
+#define HOST_IDLE_TIMEOUT_MS 10000
+#define BENCH_ADDRESS_BASE 100      // Bench servo n answers DCC address BENCH_ADDRESS_BASE + n
+#define BENCH_PACKET_INTERVAL_US 6000UL  // About one accessory packet per 6 ms on a busy bus
+#define BENCH_DISPATCH_PACKETS 100000UL
+#define BENCH_HEAP_PACKETS 1000UL
+#define BENCH_PAGE_RUNS 100
+#define BENCH_DIAG_PACKETS 1000UL
+#define BENCH_REPEAT_COUNT 4        // Times a command station sends each accessory command
+#define BENCH_ADDRESSING_PACKETS 20000UL
+#define BENCH_BOARD_BASE 26         // Board mode block: addresses 101-116, as BENCH_ADDRESS_BASE + 1
+#define BENCH_ASPECT_PACKETS 100000UL
+#define BENCH_JOURNAL_SAVES 1000
+#define BENCH_JOURNAL_STEPS 200     // Power-loss sweep: saves, each cut at every flash operation
+
+// Web pages by path, rendered into a response sink (see shims/WebServer.h)
+struct HostPage {
+    const char *path;
+    void (*send)(WebServer &server);
+};
+
+static const HostPage hostPages[] = {
+    {"/", sendHomePage},
+    {"/config", sendWiFiConfigPage},
+    {"/servo", [](WebServer &server) { sendWebAsset(server, "servo.html"); }},
+    {"/servo-config", [](WebServer &server) { sendWebAsset(server, "servo-config.html"); }},
+    {"/dcc-debug", [](WebServer &server) { sendWebAsset(server, "dcc-debug.html"); }},
+    {"/api/v1/servos", sendServoData},
+    {"/dcc-capture", [](WebServer &server) { dccCapture.send(server); }},
+};
+
+static WebServer hostWebServer(80);
+
+static uint64_t nextServoTickUs = 0;
+
+// Deterministic packet stream
+static uint32_t benchRandomState = 0x2545F491;
+
+static uint32_t benchRandom() {
+    benchRandomState ^= benchRandomState << 13;
+    benchRandomState ^= benchRandomState >> 17;
+    benchRandomState ^= benchRandomState << 5;
+    return benchRandomState;
+}
+
+static uint64_t hostNowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void bootFirmware() {
+    // Same order as setup() in main.cpp
+    initializeSerial();
+    diagLog.begin();
+    initializeEEPROM();
+    getSettings();
+    loadWiFiConfig();
+    Serial.println("Boot complete\n");
+    initializeServos();
+    servoTask.begin();
+    initializeDCC();
+    initializeWiFi();
+    diagLog.drain();
+    nextServoTickUs = hostClock.getMicros();
+}
+
+/**
+ * @brief Run the firmware up to the next loop() slot
+ *
+ * Runs any servo ticks that are due (back to back if a delay() in a command
+ * handler made them late, as vTaskDelayUntil would), then one pass of loop().
+ */
+static void runStep() {
+    while (hostClock.getMicros() >= nextServoTickUs) {
+        servoTask.tick();
+        nextServoTickUs += SERVO_UPDATE_INTERVAL * 1000UL;
+    }
+
+    processDCC();
+    recvWithEndMarker();
+    processSerialCommands();
+    eepromWriter.update();
+    servoStateLog.update(getSettledThrownMask());
+    dccCapture.update();
+    dccDebugLogger.update();
+    diagLog.drain();  // The diag task's work; the UART shim never backs up
+
+    uint64_t nextLoopUs = hostClock.getMicros() + HOST_LOOP_INTERVAL_US;
+    uint64_t stepEnd = nextLoopUs < nextServoTickUs ? nextLoopUs : nextServoTickUs;
+    hostClock.advanceUs(stepEnd - hostClock.getMicros());
+}
+
+static void runForMs(uint32_t ms) {
+    uint64_t endUs = hostClock.getMicros() + (uint64_t)ms * 1000;
+    while (hostClock.getMicros() < endUs) {
+        runStep();
+    }
+}
+
+static bool servosIdle() {
+    return getActiveServoMask() == 0 && servoCommandQueue.getDepth() == 0 &&
+           servoMoveScheduler.getWaitingCount() == 0 && hostSerial.available() == 0;
+}
+
+/**
+ * @brief Run until every servo has settled and no command is pending
+ * @return false if still busy after timeoutMs
+ */
+static bool runUntilIdle(uint32_t timeoutMs) {
+    uint64_t endUs = hostClock.getMicros() + (uint64_t)timeoutMs * 1000;
+    do {
+        runStep();
+        if (servosIdle()) return true;
+    } while (hostClock.getMicros() < endUs);
+    return false;
+}
+
+static void printHeap() {
+    printf("heap: %zu bytes in use, peak %zu, %u allocations (%llu bytes), %u frees\n",
+           hostHeap.getInUse(), hostHeap.getPeak(), hostHeap.getAllocations(),
+           (unsigned long long)hostHeap.getBytesAllocated(), hostHeap.getFrees());
+}
+
+/**
+ * @brief Encode a basic accessory packet for an output address
+ * @return Packet size
+ */
+static uint8_t encodeAccessoryPacket(uint16_t address, uint8_t direction, uint8_t power, uint8_t *packet) {
+    uint16_t board = (address - 1) / 4 + 1;
+    uint8_t pair = (address - 1) % 4;
+    packet[0] = 0x80 | (board & 0x3F);
+    packet[1] = 0x80 | ((~board >> 2) & 0x70) | ((power & 1) << 3) | (pair << 1) | (direction & 1);
+    packet[2] = packet[0] ^ packet[1];
+    return 3;
+}
+
+/**
+ * @brief Encode an extended accessory (signal aspect) packet for an output address
+ * @return Packet size
+ */
+static uint8_t encodeAspectPacket(uint16_t address, uint8_t aspect, uint8_t *packet) {
+    uint16_t board = (address - 1) / 4 + 1;
+    uint8_t pair = (address - 1) % 4;
+    packet[0] = 0x80 | (board & 0x3F);
+    packet[1] = ((~board >> 2) & 0x70) | (pair << 1) | 0x01;
+    packet[2] = aspect & 0x1F;
+    packet[3] = packet[0] ^ packet[1] ^ packet[2];
+    return 4;
+}
+
+/**
+ * @brief Output address of a basic or extended accessory packet
+ * @return Address, or 0 for any other packet
+ */
+static uint16_t accessoryAddress(const uint8_t *packet, uint8_t size) {
+    bool basic = (size == 3) && (packet[1] & 0x80);
+    bool extended = (size == 4) && ((packet[1] & 0x89) == 0x01);
+    if ((packet[0] & 0xC0) != 0x80 || !(basic || extended)) return 0;
+    uint16_t board = ((~packet[1] & 0x70) << 2) | (packet[0] & 0x3F);
+    return (((board - 1) << 2) | ((packet[1] & 0x06) >> 1)) + 1;
+}
+
+/**
+ * @brief Servo mask for a station address, found the way dispatch did before the index
+ *
+ * Reference for bench dispatch only: the original two passes over
+ * virtualservo[], one to find whether any servo answers, one to act.
+ */
+static uint16_t linearScanLookup(uint16_t address) {
+    bool isOurAddress = false;
+    for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+        if (address == virtualservo[i].address && virtualservo[i].address != 0) {
+            isOurAddress = true;
+            break;
+        }
+    }
+    if (!isOurAddress) return 0;
+
+    uint16_t servoMask = 0;
+    for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+        if (address == virtualservo[i].address) servoMask |= 1U << i;
+    }
+    return servoMask;
+}
+
+static void configureBenchServos() {
+    ServoConfigLock lock;
+    for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+        virtualservo[i].address = BENCH_ADDRESS_BASE + i;
+        virtualservo[i].swing = 25;
+        virtualservo[i].offset = 0;
+        virtualservo[i].invert = false;
+        virtualservo[i].speed = SERVO_SPEED_NORMAL_DPS;
+        virtualservo[i].easing = EASING_LINEAR;
+    }
+    refreshServoConfig();
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Time a full closed-to-thrown swing for each speed and easing profile
+ */
+static void benchMotion() {
+    static const uint16_t speeds[] = {SERVO_SPEED_FAST_DPS, SERVO_SPEED_NORMAL_DPS, SERVO_SPEED_SLOW_DPS, 45};
+    VIRTUALSERVO &vs = virtualservo[0];
+
+    printf("\n== bench motion: servo 0, %u deg swing, %d ms tick ==\n", vs.swing * 2, SERVO_UPDATE_INTERVAL);
+    printf("%-12s %6s %10s %10s %7s %7s\n", "easing", "deg/s", "expect ms", "settle ms", "ticks", "writes");
+
+    for (uint8_t easing = 0; easing < EASING_COUNT; easing++) {
+        for (uint16_t speed : speeds) {
+            {
+                ServoConfigLock lock;
+                vs.speed = speed;
+                vs.easing = easing;
+                refreshServoConfig();
+            }
+            servoCommandQueue.push(1, SERVO_CMD_CLOSE, SERVO_SRC_SERIAL);
+            runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+
+            uint32_t writesBefore = servoDriver[0].writeCount();
+            uint32_t ticksBefore = servoTask.getTickCount();
+            uint64_t startUs = hostClock.getMicros();
+            servoCommandQueue.push(1, SERVO_CMD_THROW, SERVO_SRC_SERIAL);
+
+            while (vs.state != SERVO_THROWN && hostClock.getMicros() - startUs < HOST_IDLE_TIMEOUT_MS * 1000ULL) {
+                runStep();
+            }
+            uint32_t settleMs = (uint32_t)((hostClock.getMicros() - startUs) / 1000);
+            uint32_t expectMs = (uint32_t)vs.swing * 2 * 1000 / speed;
+
+            printf("%-12s %6u %10u %10u %7u %7u\n", getServoEasingName(easing), speed, expectMs, settleMs,
+                   servoTask.getTickCount() - ticksBefore, servoDriver[0].writeCount() - writesBefore);
+            runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+        }
+    }
+}
+
+static volatile uint16_t benchLookupSink;  // Keeps timed lookups from being optimized away
+
+/**
+ * @brief Time address lookups over a recorded stream, one path at a time
+ * @return ns for the whole stream
+ */
+static uint64_t timeLookups(const uint16_t *addresses, uint32_t count, bool linearScan) {
+    uint16_t sink = 0;
+    uint64_t startNs = hostNowNs();
+    if (linearScan) {
+        for (uint32_t n = 0; n < count; n++) sink ^= linearScanLookup(addresses[n]);
+    } else {
+        for (uint32_t n = 0; n < count; n++) sink ^= dccAddressIndex.lookup(addresses[n]);
+    }
+    uint64_t elapsedNs = hostNowNs() - startNs;
+    benchLookupSink = sink;
+    return elapsedNs;
+}
+
+/**
+ * @brief Decode a busy packet stream and time dispatch and motion start
+ *
+ * Host ns per packet is the cost on this machine. The recorded stream is
+ * replayed through the address index and through the linear scan it replaced
+ * (linearScanLookup), which must agree on every packet. The callback is
+ * notifyDccAccTurnoutOutput as built; everything after the lookup is the same
+ * for both, so its "before" figure is the callback with the scan's cost in
+ * place of the index's.
+ *
+ * Latency is virtual time from a packet that changes a turnout to the first
+ * pulse change on its servo, so it includes queueing for a move slot.
+ * @return 0 if both lookups agree, 1 otherwise
+ */
+static int benchDispatch() {
+    static uint16_t foreignStream[BENCH_DISPATCH_PACKETS];
+    static uint16_t matchedStream[BENCH_DISPATCH_PACKETS];
+    const uint32_t addressRange = 200;  // Addresses 1..200, of which TOTAL_PINS are ours
+    uint8_t desired[TOTAL_PINS] = {};
+    uint64_t pendingSinceUs[TOTAL_PINS] = {};
+    int pendingPulse[TOTAL_PINS] = {};
+    uint16_t pendingMask = 0;
+
+    uint64_t foreignNs = 0, matchedNs = 0;
+    uint32_t foreignCount = 0, matchedCount = 0;
+    uint64_t latencyTotalUs = 0, latencyMaxUs = 0;
+    uint32_t latencyCount = 0;
+    uint32_t droppedBefore = servoCommandQueue.getDroppedCount();
+
+    for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+        desired[i] = (virtualservo[i].state == SERVO_THROWN) ? 1 : 0;
+    }
+
+    hostSerial.setMuted(true);
+    uint64_t nextPacketUs = hostClock.getMicros();
+    for (uint32_t n = 0; n < BENCH_DISPATCH_PACKETS; n++) {
+        while (hostClock.getMicros() < nextPacketUs) {
+            runStep();
+
+            for (uint16_t mask = pendingMask; mask; mask &= mask - 1) {
+                uint8_t i = __builtin_ctz(mask);
+                if (servoDriver[i].readMicroseconds() != pendingPulse[i]) {
+                    uint64_t latencyUs = hostClock.getMicros() - pendingSinceUs[i];
+                    latencyTotalUs += latencyUs;
+                    if (latencyUs > latencyMaxUs) latencyMaxUs = latencyUs;
+                    latencyCount++;
+                    pendingMask &= ~(1U << i);
+                }
+            }
+        }
+        nextPacketUs += BENCH_PACKET_INTERVAL_US;
+
+        uint16_t addr = 1 + benchRandom() % addressRange;
+        uint8_t direction = benchRandom() & 1;
+        int servo = (int)addr - BENCH_ADDRESS_BASE;
+        bool ours = (servo >= 0 && servo < TOTAL_PINS);
+
+        if (ours && direction != desired[servo]) {
+            if (pendingMask & (1U << servo)) {
+                // Sent back before it started moving: nothing to time
+                pendingMask &= ~(1U << servo);
+            } else {
+                pendingSinceUs[servo] = hostClock.getMicros();
+                pendingPulse[servo] = servoDriver[servo].readMicroseconds();
+                pendingMask |= 1U << servo;
+            }
+            desired[servo] = direction;
+        }
+
+        uint16_t station = dccAddressIndex.toStationAddress(addr);
+        if (ours) matchedStream[matchedCount] = station;
+        else foreignStream[foreignCount] = station;
+
+        uint64_t startNs = hostNowNs();
+        notifyDccAccTurnoutOutput(addr, direction, 1);
+        uint64_t elapsedNs = hostNowNs() - startNs;
+
+        if (ours) { matchedNs += elapsedNs; matchedCount++; }
+        else { foreignNs += elapsedNs; foreignCount++; }
+    }
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+    hostSerial.setMuted(false);
+
+    // The same packets through both lookups: they must resolve to the same servos
+    uint32_t mismatches = 0;
+    for (uint32_t n = 0; n < foreignCount; n++) {
+        if (linearScanLookup(foreignStream[n]) != dccAddressIndex.lookup(foreignStream[n])) mismatches++;
+    }
+    for (uint32_t n = 0; n < matchedCount; n++) {
+        if (linearScanLookup(matchedStream[n]) != dccAddressIndex.lookup(matchedStream[n])) mismatches++;
+    }
+
+    double perForeign = foreignCount ? 1.0 / foreignCount : 0.0;
+    double perMatched = matchedCount ? 1.0 / matchedCount : 0.0;
+    double scanForeign = timeLookups(foreignStream, foreignCount, true) * perForeign;
+    double scanMatched = timeLookups(matchedStream, matchedCount, true) * perMatched;
+    double indexForeign = timeLookups(foreignStream, foreignCount, false) * perForeign;
+    double indexMatched = timeLookups(matchedStream, matchedCount, false) * perMatched;
+    double callbackForeign = foreignNs * perForeign;
+    double callbackMatched = matchedNs * perMatched;
+
+    printf("\n== bench dispatch: %lu packets, one per %lu us, %s debug ==\n", BENCH_DISPATCH_PACKETS,
+           BENCH_PACKET_INTERVAL_US, dccDebugLogger.isDebugEnabled() ? "with" : "without");
+    printf("%-26s %14s %14s\n", "host ns/packet", "scan (before)", "index (after)");
+    printf("%-26s %14.1f %14.1f\n", "lookup, foreign", scanForeign, indexForeign);
+    printf("%-26s %14.1f %14.1f\n", "lookup, matched", scanMatched, indexMatched);
+    printf("%-26s %14.1f %14.1f\n", "callback, foreign", callbackForeign - indexForeign + scanForeign, callbackForeign);
+    printf("%-26s %14.1f %14.1f\n", "callback, matched", callbackMatched - indexMatched + scanMatched, callbackMatched);
+    printf("packets: %u foreign, %u matched; lookups disagree on %u\n", foreignCount, matchedCount, mismatches);
+
+    printf("\n== bench dispatch: packet to motion (virtual time) ==\n");
+    printf("latency: %u moves, avg %.2f ms, max %.2f ms\n", latencyCount,
+           latencyCount ? latencyTotalUs / 1000.0 / latencyCount : 0.0, latencyMaxUs / 1000.0);
+    printf("queue: peak depth %u, dropped %u\n", servoCommandQueue.getPeakDepth(),
+           servoCommandQueue.getDroppedCount() - droppedBefore);
+    printf("moves: peak %u moving, %u queued\n", servoMoveScheduler.getPeakMoving(), servoMoveScheduler.getPeakWaiting());
+    return mismatches ? 1 : 0;
+}
+
+/**
+ * @brief Heap traffic per decoded packet, with the debug logger off and on
+ */
+static void benchHeap() {
+    printf("\n== bench heap: %lu packets per run, half of them ours ==\n", BENCH_HEAP_PACKETS);
+    printf("%-10s %12s %12s %12s %12s\n", "debug", "allocs/pkt", "bytes/pkt", "retained", "peak");
+
+    bool wasEnabled = dccDebugLogger.isDebugEnabled();
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 0) dccDebugLogger.disableDebug();
+        else dccDebugLogger.enableDebug();
+
+        hostSerial.setMuted(true);
+        runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+        hostHeap.resetPeak();
+        size_t inUseBefore = hostHeap.getInUse();
+        uint32_t allocsBefore = hostHeap.getAllocations();
+        uint64_t bytesBefore = hostHeap.getBytesAllocated();
+
+        for (uint32_t n = 0; n < BENCH_HEAP_PACKETS; n++) {
+            uint16_t addr = (n & 1) ? BENCH_ADDRESS_BASE + (n >> 1) % TOTAL_PINS : 1 + n % 50;
+            notifyDccAccTurnoutOutput(addr, (n >> 5) & 1, 1);
+            if ((n & 7) == 7) runForMs(SERVO_UPDATE_INTERVAL);
+        }
+        runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+        hostSerial.setMuted(false);
+
+        // Servo ticks in between do not allocate, so this is all packet handling
+        uint32_t allocs = hostHeap.getAllocations() - allocsBefore;
+        uint64_t bytes = hostHeap.getBytesAllocated() - bytesBefore;
+        printf("%-10s %12.2f %12.1f %12ld %12zu\n", pass ? "on" : "off", (double)allocs / BENCH_HEAP_PACKETS,
+               (double)bytes / BENCH_HEAP_PACKETS, (long)hostHeap.getInUse() - (long)inUseBefore,
+               hostHeap.getPeak() - inUseBefore);
+    }
+
+    if (wasEnabled) dccDebugLogger.enableDebug();
+    else dccDebugLogger.disableDebug();
+    printHeap();
+}
+
+/**
+ * @brief Heap and time per web page render
+ *
+ * Peak is the most heap held above the starting point at any moment during
+ * the render; host us is the render cost on this machine, sending excluded.
+ */
+static void benchPages() {
+    printf("\n== bench pages: %d renders each ==\n", BENCH_PAGE_RUNS);
+    printf("%-14s %8s %7s %9s %11s %9s\n", "page", "bytes", "chunks", "peak", "allocs", "host us");
+
+    for (const HostPage &hostPage : hostPages) {
+        uint64_t totalNs = 0;
+        size_t peak = 0;
+        uint32_t allocs = 0;
+        for (int run = 0; run < BENCH_PAGE_RUNS; run++) {
+            hostWebServer.resetResponse();
+            hostHeap.resetPeak();
+            size_t inUseBefore = hostHeap.getInUse();
+            uint32_t allocsBefore = hostHeap.getAllocations();
+
+            uint64_t startNs = hostNowNs();
+            hostPage.send(hostWebServer);
+            totalNs += hostNowNs() - startNs;
+
+            if (hostHeap.getPeak() - inUseBefore > peak) peak = hostHeap.getPeak() - inUseBefore;
+            allocs += hostHeap.getAllocations() - allocsBefore;
+        }
+        printf("%-14s %8zu %7u %9zu %11.1f %9.1f\n", hostPage.path, hostWebServer.getBytesSent(),
+               hostWebServer.getChunkCount(), peak, (double)allocs / BENCH_PAGE_RUNS,
+               totalNs / 1000.0 / BENCH_PAGE_RUNS);
+    }
+}
+
+/**
+ * @brief Settings journal: flash wear per save, and power loss at every write
+ *
+ * Part one saves a single servo change BENCH_JOURNAL_SAVES times through the
+ * firmware's own path, then makes the flash refuse one save: it must stay
+ * pending, and the next flush must store it. Part two runs a fixed sequence of saves on a separate
+ * journal; for each save it cuts the power after every possible number of
+ * flash operations, reboots, and checks the settings come back as either the
+ * old or the new image - and that the next save after the reboot sticks.
+ */
+static int benchJournal() {
+    static uint8_t flashCopy[HOST_FLASH_SIZE];
+    static uint8_t stepBase[HOST_FLASH_SIZE];
+    static uint8_t images[BENCH_JOURNAL_STEPS + 1][EEPROM_SIZE];
+    static uint8_t loaded[EEPROM_SIZE];
+
+    printf("\n== bench journal: %d saves, power cut sweep over %d saves ==\n", BENCH_JOURNAL_SAVES,
+           BENCH_JOURNAL_STEPS);
+    if (!configJournal.isReady()) {
+        printf("journal not in use\n");
+        return 1;
+    }
+
+    hostSerial.setMuted(true);
+    uint32_t erasesBefore = configJournal.getEraseCount();
+    uint32_t bytesBefore = configJournal.getBytesAppended();
+    uint32_t appendsBefore = configJournal.getAppendCount();
+    for (uint32_t n = 0; n < BENCH_JOURNAL_SAVES; n++) {
+        virtualservo[n % TOTAL_PINS].offset = (int8_t)(n % 7) - 3;
+        bootController.isDirty = true;
+        putSettings();
+        flushSettings();
+    }
+    hostSerial.setMuted(false);
+
+    uint32_t appends = configJournal.getAppendCount() - appendsBefore;
+    uint32_t erases = configJournal.getEraseCount() - erasesBefore;
+    printf("saves %u, bytes/save %.1f (image %d), sector erases %u (whole-image commits: %u), most worn sector %u\n",
+           appends, (double)(configJournal.getBytesAppended() - bytesBefore) / (appends ? appends : 1), EEPROM_SIZE,
+           erases, appends, configJournal.getMaxSectorErases());
+
+    hostSerial.setMuted(true);
+    virtualservo[0].offset = 4;  // Not one of the offsets above
+    bootController.isDirty = true;
+    putSettings();
+    uint32_t failedBefore = eepromWriter.getFailedCount();
+    hostFlash.failNextCalls(1);
+    bool refused = !eepromWriter.flush() && eepromWriter.isPending() && eepromWriter.getFailedCount() == failedBefore + 1;
+    bool retried = eepromWriter.flush() && !eepromWriter.isPending();
+    bool stored;
+    {
+        ConfigJournal rebooted;
+        stored = rebooted.begin(CONFIG_JOURNAL_PARTITION, loaded, EEPROM_SIZE) &&
+                 memcmp(loaded, EEPROM.getDataPtr(), EEPROM_SIZE) == 0;
+    }
+    hostSerial.setMuted(false);
+    bool failedSaveOk = refused && retried && stored;
+    printf("failed save: refused and kept pending %s, stored by the retry %s -> %s\n", refused ? "yes" : "no",
+           (retried && stored) ? "yes" : "no", failedSaveOk ? "pass" : "FAIL");
+
+    // Sweep on a scratch copy of the flash; the firmware's journal gets its own back afterwards
+    hostFlash.save(flashCopy);
+    memset(stepBase, 0xFF, sizeof(stepBase));
+    hostFlash.load(stepBase);
+
+    for (int j = 0; j < BENCH_JOURNAL_STEPS; j++) {
+        memcpy(images[j + 1], images[j], EEPROM_SIZE);
+        // Mostly a few bytes, now and then enough scattered changes to force a snapshot
+        int changes = (j % 25 == 24) ? 40 : 1 + benchRandom() % 6;
+        for (int c = 0; c < changes; c++) {
+            images[j + 1][benchRandom() % EEPROM_SIZE] = (uint8_t)benchRandom();
+        }
+    }
+
+    uint32_t cuts = 0;
+    uint32_t failures = 0;
+    uint32_t oldKept = 0;
+    uint32_t newKept = 0;
+    uint32_t compactions = 0;
+    {
+        ConfigJournal journal;
+        memcpy(loaded, images[0], EEPROM_SIZE);
+        journal.begin(CONFIG_JOURNAL_PARTITION, loaded, EEPROM_SIZE);
+    }
+
+    for (int j = 0; j < BENCH_JOURNAL_STEPS; j++) {
+        hostFlash.save(stepBase);
+
+        // Flash operations this save takes when nothing goes wrong
+        uint64_t units;
+        {
+            ConfigJournal journal;
+            journal.begin(CONFIG_JOURNAL_PARTITION, loaded, EEPROM_SIZE);
+            uint64_t before = hostFlash.getOperations();
+            journal.append(images[j + 1]);
+            units = hostFlash.getOperations() - before;
+            compactions += journal.getCompactCount();
+        }
+
+        for (uint64_t k = 0; k < units; k++) {
+            hostFlash.load(stepBase);
+            {
+                ConfigJournal journal;
+                journal.begin(CONFIG_JOURNAL_PARTITION, loaded, EEPROM_SIZE);
+                hostFlash.cutPowerAfter(k);
+                journal.append(images[j + 1]);
+                hostFlash.restorePower();
+            }
+            cuts++;
+
+            bool ok;
+            {
+                ConfigJournal rebooted;
+                ok = rebooted.begin(CONFIG_JOURNAL_PARTITION, loaded, EEPROM_SIZE);
+                bool isOld = ok && memcmp(loaded, images[j], EEPROM_SIZE) == 0;
+                ok = ok && (isOld || memcmp(loaded, images[j + 1], EEPROM_SIZE) == 0);
+                ok = ok && rebooted.append(images[j + 1]);
+                if (ok) (isOld ? oldKept : newKept)++;
+            }
+            {
+                ConfigJournal rebooted;
+                ok = ok && rebooted.begin(CONFIG_JOURNAL_PARTITION, loaded, EEPROM_SIZE) &&
+                     memcmp(loaded, images[j + 1], EEPROM_SIZE) == 0;
+            }
+            if (!ok) {
+                if (failures < 10) printf("FAIL: save %d, power cut after %llu of %llu operations\n", j,
+                                          (unsigned long long)k, (unsigned long long)units);
+                failures++;
+            }
+        }
+
+        // On to the next save from a clean write
+        hostFlash.load(stepBase);
+        ConfigJournal journal;
+        journal.begin(CONFIG_JOURNAL_PARTITION, loaded, EEPROM_SIZE);
+        journal.append(images[j + 1]);
+        memcpy(loaded, images[j + 1], EEPROM_SIZE);
+    }
+
+    hostFlash.load(flashCopy);
+    printf("power cuts %u (old image back %u, new image %u), snapshots %u, failures %u\n", cuts, oldKept,
+           newKept, compactions, failures);
+    return (failures || !failedSaveOk) ? 1 : 0;
+}
+
+// Settings every layout snapshot holds, so each one can be checked after loading
+static void fillLegacyWiFi(LegacyWiFiV1 *v1, LegacyWiFiV2 *v2) {
+    uint8_t *enabled = v1 ? &v1->enabled : &v2->enabled;
+    int32_t *mode = v1 ? &v1->mode : &v2->mode;
+    char *stationSSID = v1 ? v1->stationSSID : v2->stationSSID;
+    char *apSSID = v1 ? v1->apSSID : v2->apSSID;
+    uint8_t *useStaticIP = v1 ? &v1->useStaticIP : &v2->useStaticIP;
+    LegacyIPAddress *ips = v1 ? &v1->staticIP : &v2->staticIP;
+
+    *enabled = 1;
+    *mode = DCC_WIFI_STATION;
+    strcpy(stationSSID, "yard-net");
+    strcpy(apSSID, "DCCAC_LAYOUT");
+    *useStaticIP = 1;
+    for (int i = 0; i < 5; i++) {
+        ips[i].vtable = 0x3F400000 + i * 8;  // Whatever the ESP32 had there
+        ips[i].bytes[0] = 10;
+        ips[i].bytes[1] = 0;
+        ips[i].bytes[2] = 0;
+        ips[i].bytes[3] = 50 + i;
+    }
+    if (v2) strcpy(v2->hostname, "yard");
+}
+
+/**
+ * @brief Write the EEPROM image a released firmware version left behind
+ */
+static void writeLegacySnapshot(int32_t version) {
+    uint8_t *image = EEPROM.getDataPtr();
+    memset(image, 0xFF, EEPROM_COMMIT_COUNT_ADDRESS);
+
+    LegacyController controller = {version, 0, {0, 0, 0}, 0};
+    memcpy(image, &controller, sizeof(controller));
+
+    for (int i = 0; i < TOTAL_PINS; i++) {
+        LegacyServoV4 servo = {(uint8_t)pwmPins[i], 0, (uint16_t)(200 + i), (uint8_t)(10 + i), (int8_t)(i % 5 - 2),
+                               (uint8_t)(i % SPEED_PRESET_COUNT), (uint8_t)(i & 1), (uint8_t)(i % 3 == 0), 2, 90, 0, 0x3FFB0000};
+        memcpy(image + LEGACY_SERVOS_ADDRESS + i * sizeof(LegacyServoV4), &servo, sizeof(servo));
+    }
+
+    if (version < LEGACY_LAYOUT_V4_HOSTNAME) {
+        LegacyWiFiV1 wifi;
+        memset(&wifi, 0, sizeof(wifi));
+        fillLegacyWiFi(&wifi, nullptr);
+        memcpy(image + LEGACY_WIFI_ADDRESS, &wifi, sizeof(wifi));
+    } else {
+        LegacyWiFiV2 wifi;
+        memset(&wifi, 0, sizeof(wifi));
+        fillLegacyWiFi(nullptr, &wifi);
+        memcpy(image + LEGACY_WIFI_ADDRESS, &wifi, sizeof(wifi));
+    }
+}
+
+/**
+ * @brief Check the loaded settings against those writeLegacySnapshot() stored
+ * @return Number of mismatches
+ */
+static int checkSnapshotSettings(int32_t version, bool checkWiFi, bool report = true) {
+    int errors = 0;
+    uint8_t aspects[SERVO_ASPECT_COUNT];
+    setDefaultServoAspects(aspects);  // No released layout stored an aspect table
+    for (int i = 0; i < TOTAL_PINS; i++) {
+        const VIRTUALSERVO &s = virtualservo[i];
+        uint16_t speed = getServoSpeedPreset(i % SPEED_PRESET_COUNT);
+        if (s.address != 200 + i || s.swing != 10 + i || s.offset != i % 5 - 2 || s.speed != speed ||
+            s.easing != EASING_LINEAR || s.invert != (bool)(i & 1) || s.continuous != (i % 3 == 0) ||
+            memcmp(s.aspects, aspects, sizeof(aspects)) != 0) {
+            if (report && errors < 4) printf("  servo %d: addr %u swing %u offset %d speed %u easing %u invert %d cont %d\n", i,
+                                   s.address, s.swing, s.offset, s.speed, s.easing, s.invert, s.continuous);
+            errors++;
+        }
+    }
+    if (checkWiFi) {
+        const char *hostname = (version < LEGACY_LAYOUT_V4_HOSTNAME) ? "dccservo" : "yard";
+        if (wifiConfig.mode != DCC_WIFI_STATION || strcmp(wifiConfig.stationSSID, "yard-net") ||
+            strcmp(wifiConfig.apSSID, "DCCAC_LAYOUT") || strcmp(wifiConfig.hostname, hostname) ||
+            !wifiConfig.useStaticIP || wifiConfig.staticIP != IPAddress(10, 0, 0, 50) ||
+            wifiConfig.dns2 != IPAddress(10, 0, 0, 54)) {
+            printf("  wifi: mode %d ssid '%s' ap '%s' host '%s' ip %s\n", wifiConfig.mode, wifiConfig.stationSSID,
+                   wifiConfig.apSSID, wifiConfig.hostname, wifiConfig.staticIP.toString().c_str());
+            errors++;
+        }
+    }
+    return errors;
+}
+
+static void loadSettings() {
+    hostSerial.setMuted(true);
+    getSettings();
+    loadWiFiConfig();
+    hostSerial.setMuted(false);
+}
+
+/**
+ * @brief Boot from the settings of every released layout
+ *
+ * Each snapshot is the byte image that version stored on the ESP32. After
+ * loading, the settings must match, the image must be in the current layout,
+ * and a second boot must load the same settings without writing anything.
+ * Then the same for damaged records: only the damaged part may fall back to
+ * defaults.
+ */
+static int benchLayouts() {
+    static const int32_t layouts[] = {400, 402, 403};
+    int failures = 0;
+
+    printf("\n== bench layouts: %u released layouts, settings image now %u bytes ==\n",
+           (unsigned)(sizeof(layouts) / sizeof(layouts[0])), (unsigned)(SETTINGS_END_ADDRESS + sizeof(SettingsRecordHeader)));
+    printf("%-10s %8s %10s %8s %8s\n", "layout", "loaded", "converted", "reboot", "result");
+
+    for (int32_t version : layouts) {
+        writeLegacySnapshot(version);
+        loadSettings();
+        int errors = checkSnapshotSettings(version, true);
+
+        SettingsStoreHeader store;
+        EEPROM.get(0, store);
+        bool converted = (store.magic == SETTINGS_STORE_MAGIC) && !eepromWriter.isPending();
+
+        uint32_t commitsBefore = eepromWriter.getCommitCount();
+        loadSettings();
+        int rebootErrors = checkSnapshotSettings(version, true);
+        bool quiet = eepromWriter.getCommitCount() == commitsBefore;
+
+        bool ok = errors == 0 && converted && rebootErrors == 0 && quiet;
+        printf("v0.%d.%d %12s %10s %8s %8s\n", version / 100, version % 100, errors ? "WRONG" : "ok",
+               converted ? "yes" : "no", rebootErrors ? "WRONG" : (quiet ? "ok" : "rewrote"), ok ? "pass" : "FAIL");
+        if (!ok) failures++;
+    }
+
+    // Damage one byte of a record in the current layout
+    struct Damage {
+        const char *name;
+        uint32_t address;
+        bool servosKept;
+        bool wifiKept;
+    };
+    static const Damage damages[] = {
+        {"servos", SETTINGS_SERVOS_ADDRESS + sizeof(SettingsRecordHeader) + 3, false, false},
+        {"wifi", SETTINGS_WIFI_ADDRESS + sizeof(SettingsRecordHeader) + 40, true, false},
+    };
+    for (const Damage &damage : damages) {
+        writeLegacySnapshot(LEGACY_LAYOUT_V4_HOSTNAME);
+        loadSettings();
+        EEPROM.getDataPtr()[damage.address] ^= 0x10;
+        loadSettings();
+
+        bool servosKept = checkSnapshotSettings(LEGACY_LAYOUT_V4_HOSTNAME, false, false) == 0;
+        bool wifiKept = strcmp(wifiConfig.stationSSID, "yard-net") == 0;
+        bool servosDefault = virtualservo[3].address == 0 && virtualservo[3].swing == 25;
+        bool ok = servosKept == damage.servosKept && wifiKept == damage.wifiKept &&
+                  (servosKept || servosDefault);
+        printf("%-10s %8s %10s %8s %8s\n", damage.name, servosKept ? "servos" : "defaults",
+               wifiKept ? "wifi" : "defaults", "", ok ? "pass" : "FAIL");
+        if (!ok) failures++;
+    }
+
+    printf("failures %d\n", failures);
+    return failures ? 1 : 0;
+}
+
+/**
+ * @brief Cost and output of per-packet diagnostics, at info and at debug level
+ *
+ * Board packets are logged at debug level: at info they must cost no more
+ * than the level check, at debug the rate limit must hold the output to
+ * DIAG_RATE_PER_SEC, and every message must be either written out or counted
+ * as dropped.
+ */
+static int benchDiag() {
+    int failures = 0;
+    uint8_t wasLevel = diagLog.getLevel();
+
+    printf("\n== bench diag: %lu board packets, one per %lu us ==\n", BENCH_DIAG_PACKETS, BENCH_PACKET_INTERVAL_US);
+    printf("%-8s %10s %10s %10s %12s\n", "level", "ns/pkt", "logged", "dropped", "bytes out");
+
+    const uint8_t levels[] = {DIAG_LEVEL_INFO, DIAG_LEVEL_DEBUG};
+    for (uint8_t level : levels) {
+        diagLog.setLevel(level);
+        hostSerial.setMuted(true);
+        runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+        diagLog.resetStats();
+        uint64_t bytesBefore = hostSerial.getBytesWritten();
+
+        uint64_t packetNs = 0;
+        uint64_t nextPacketUs = hostClock.getMicros();
+        for (uint32_t n = 0; n < BENCH_DIAG_PACKETS; n++) {
+            while (hostClock.getMicros() < nextPacketUs) {
+                runStep();
+            }
+            nextPacketUs += BENCH_PACKET_INTERVAL_US;
+
+            uint64_t startNs = hostNowNs();
+            notifyDccAccTurnoutBoard(1 + n % 511, n & 3, (n >> 2) & 1, 1);
+            packetNs += hostNowNs() - startNs;
+        }
+        runForMs(100);
+        hostSerial.setMuted(false);
+
+        uint32_t logged = diagLog.getLoggedCount();
+        uint32_t dropped = diagLog.getDroppedCount();
+        uint32_t expectedMax = DIAG_BURST + BENCH_DIAG_PACKETS * BENCH_PACKET_INTERVAL_US / 1000000UL * DIAG_RATE_PER_SEC + 1;
+        bool ok = (diagLog.getQueuedBytes() == 0) &&
+                  ((level < DIAG_LEVEL_DEBUG) ? (logged == 0 && dropped == 0)
+                                              : (logged + dropped == BENCH_DIAG_PACKETS && logged <= expectedMax));
+        if (!ok) failures++;
+
+        printf("%-8s %10.0f %10u %10u %12llu%s\n", DiagLog::getLevelName(level), (double)packetNs / BENCH_DIAG_PACKETS,
+               logged, dropped, (unsigned long long)(hostSerial.getBytesWritten() - bytesBefore), ok ? "" : "  FAIL");
+    }
+
+    diagLog.setLevel(wasLevel);
+    diagLog.resetStats();
+    printf("failures %d\n", failures);
+    return failures ? 1 : 0;
+}
+
+/**
+ * @brief Repeated accessory packets, as a command station sends them
+ *
+ * Each command goes out BENCH_REPEAT_COUNT times as an OutputPower=1 and an
+ * OutputPower=0 packet. Only the first packet of a command may reach the
+ * servo queue, repeats arriving while the servo moves must not touch it, a
+ * reversal must pass at once, and the same command after the window is new.
+ */
+static int benchRepeats() {
+    const uint8_t servo = 0;
+    const uint16_t address = BENCH_ADDRESS_BASE + servo;
+    int failures = 0;
+
+    printf("\n== bench repeats: servo %u, each command sent %d times (power on and off), window %d ms ==\n", servo,
+           BENCH_REPEAT_COUNT, DCC_REPEAT_WINDOW_MS);
+    printf("%-28s %8s %8s %8s\n", "step", "packets", "queued", "ignored");
+
+    struct Step {
+        const char *name;
+        uint8_t direction;
+        uint32_t waitBeforeMs;
+        uint32_t expectQueued;
+    };
+    const Step steps[] = {
+        {"throw", 1, 0, 1},
+        {"throw again while moving", 1, 50, 0},
+        {"close (reversal)", 0, 10, 1},
+        {"close after the window", 0, DCC_REPEAT_WINDOW_MS + 100, 1},
+    };
+
+    hostSerial.setMuted(true);
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+    dccRepeatFilter.clear();
+
+    for (const Step &step : steps) {
+        runForMs(step.waitBeforeMs);
+        uint32_t pushedBefore = servoCommandQueue.getPushedCount();
+        uint32_t ignoredBefore = dccRepeatFilter.getSuppressedCount();
+
+        uint64_t nextPacketUs = hostClock.getMicros();
+        for (uint8_t n = 0; n < BENCH_REPEAT_COUNT * 2; n++) {
+            while (hostClock.getMicros() < nextPacketUs) {
+                runStep();
+            }
+            nextPacketUs += BENCH_PACKET_INTERVAL_US;
+            notifyDccAccTurnoutOutput(address, step.direction, (n & 1) ? 0 : 1);
+        }
+
+        uint32_t queued = servoCommandQueue.getPushedCount() - pushedBefore;
+        uint32_t ignored = dccRepeatFilter.getSuppressedCount() - ignoredBefore;
+        bool ok = (queued == step.expectQueued) && (queued + ignored == BENCH_REPEAT_COUNT * 2);
+        if (!ok) failures++;
+        printf("%-28s %8d %8u %8u%s\n", step.name, BENCH_REPEAT_COUNT * 2, queued, ignored, ok ? "" : "  FAIL");
+    }
+
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+    hostSerial.setMuted(false);
+    if (virtualservo[servo].state != SERVO_CLOSED) {
+        printf("servo %u ended in state %d, expected closed  FAIL\n", servo, virtualservo[servo].state);
+        failures++;
+    }
+
+    printf("failures %d\n", failures);
+    return failures ? 1 : 0;
+}
+
+/**
+ * @brief Set the addressing mode as the sm command does
+ */
+static void setBenchAddressing(uint8_t mode, uint16_t boardBase, uint8_t shift) {
+    DccAddressing settings;
+    settings.mode = mode;
+    settings.boardBase = boardBase;
+    settings.shift = shift;
+    ServoConfigLock lock;
+    dccAddressIndex.configure(settings);
+    refreshServoConfig();
+}
+
+/**
+ * @brief Board and output addressing, with and without the +4 shift
+ *
+ * Every board and output pair a packet can carry must resolve to the servo
+ * the command station means, both through the board lookup and through the
+ * station address; a packet fed to the decoder must move that servo; the
+ * mode must survive a reboot; and dispatch cost is compared between modes.
+ */
+static int benchAddressing() {
+    int failures = 0;
+
+    printf("\n== bench addressing: board mode from board %d, %lu packets per mode ==\n", BENCH_BOARD_BASE,
+           BENCH_ADDRESSING_PACKETS);
+    printf("%-8s %-6s %8s %8s %10s %8s\n", "mode", "shift", "outputs", "wrong", "ns/pkt", "result");
+
+    const uint8_t modes[] = {DCC_ADDRESS_MODE_OUTPUT, DCC_ADDRESS_MODE_BOARD};
+    const uint8_t shifts[] = {DCC_ADDRESS_SHIFT_NONE, DCC_ADDRESS_SHIFT_BOARD};
+    hostSerial.setMuted(true);
+    for (uint8_t mode : modes) {
+        for (uint8_t shift : shifts) {
+            setBenchAddressing(mode, BENCH_BOARD_BASE, shift);
+
+            // Every board (9 bits) and pair a packet can carry
+            uint32_t wrong = 0;
+            for (uint16_t board = 0; board < 512; board++) {
+                for (uint8_t pair = 0; pair < DCC_BOARD_OUTPUTS; pair++) {
+                    uint16_t station = ((board - 1) * DCC_BOARD_OUTPUTS + pair + 1 + shift) & 0xFFFF;
+                    uint16_t expected = 0;
+                    if (mode == DCC_ADDRESS_MODE_BOARD) {
+                        uint16_t first = (BENCH_BOARD_BASE - 1) * DCC_BOARD_OUTPUTS + 1;
+                        if (station >= first && station < first + TOTAL_PINS) expected = 1U << (station - first);
+                    } else if (station >= BENCH_ADDRESS_BASE && station < BENCH_ADDRESS_BASE + TOTAL_PINS) {
+                        expected = 1U << (station - BENCH_ADDRESS_BASE);
+                    }
+                    uint16_t packetAddress = ((board - 1) * DCC_BOARD_OUTPUTS + pair + 1) & 0xFFFF;
+                    uint16_t found = (mode == DCC_ADDRESS_MODE_BOARD) ? dccAddressIndex.lookupBoard(board, pair)
+                                                                      : dccAddressIndex.lookup(dccAddressIndex.toStationAddress(packetAddress));
+                    if (found != expected || dccAddressIndex.lookup(dccAddressIndex.toStationAddress(board, pair)) != expected) {
+                        wrong++;
+                    }
+                }
+            }
+
+            // A packet for the last servo, as the station sends it, must throw that servo
+            uint8_t servo = TOTAL_PINS - 1;
+            uint16_t station = (mode == DCC_ADDRESS_MODE_BOARD) ? (BENCH_BOARD_BASE - 1) * DCC_BOARD_OUTPUTS + 1 + servo
+                                                                : BENCH_ADDRESS_BASE + servo;
+            uint8_t packet[3];
+            dccRepeatFilter.clear();
+            Dcc.feed(packet, encodeAccessoryPacket(station - shift, 0, 1, packet));
+            runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+            Dcc.feed(packet, encodeAccessoryPacket(station - shift, 1, 1, packet));
+            runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+            bool moved = virtualservo[servo].state == SERVO_THROWN;
+
+            // Decode cost of random accessory packets through both callbacks
+            uint64_t packetNs = 0;
+            uint64_t nextPacketUs = hostClock.getMicros();
+            for (uint32_t n = 0; n < BENCH_ADDRESSING_PACKETS; n++) {
+                while (hostClock.getMicros() < nextPacketUs) {
+                    runStep();
+                }
+                nextPacketUs += BENCH_PACKET_INTERVAL_US;
+                uint32_t r = benchRandom();
+                uint8_t length = encodeAccessoryPacket(1 + r % DCC_MAX_ADDRESS, (r >> 16) & 1, 1, packet);
+                uint64_t startNs = hostNowNs();
+                Dcc.feed(packet, length);
+                packetNs += hostNowNs() - startNs;
+            }
+            runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+
+            bool ok = wrong == 0 && moved;
+            if (!ok) failures++;
+            hostSerial.setMuted(false);
+            printf("%-8s %-6s %8u %8u %10.0f %8s%s\n", mode == DCC_ADDRESS_MODE_BOARD ? "board" : "output",
+                   DccAddressIndex::getShiftName(shift), 512 * DCC_BOARD_OUTPUTS, wrong,
+                   (double)packetNs / BENCH_ADDRESSING_PACKETS, ok ? "pass" : "FAIL", moved ? "" : " (servo did not move)");
+            hostSerial.setMuted(true);
+        }
+    }
+
+    // The mode is a setting: it must come back after a reboot, servo addresses untouched
+    setBenchAddressing(DCC_ADDRESS_MODE_BOARD, BENCH_BOARD_BASE, DCC_ADDRESS_SHIFT_BOARD);
+    bootController.isDirty = true;
+    putSettings();
+    flushSettings();
+    loadSettings();
+    hostSerial.setMuted(true);
+    const DccAddressing &loaded = dccAddressIndex.getAddressing();
+    bool kept = loaded.mode == DCC_ADDRESS_MODE_BOARD && loaded.boardBase == BENCH_BOARD_BASE &&
+                loaded.shift == DCC_ADDRESS_SHIFT_BOARD && virtualservo[1].address == BENCH_ADDRESS_BASE + 1 &&
+                dccAddressIndex.getServoAddress(1) == (BENCH_BOARD_BASE - 1) * DCC_BOARD_OUTPUTS + 2;
+    if (!kept) failures++;
+    hostSerial.setMuted(false);
+    printf("reboot: board mode from board %u, shift %s%s\n", loaded.boardBase, DccAddressIndex::getShiftName(loaded.shift),
+           kept ? "" : "  FAIL");
+    hostSerial.setMuted(true);
+
+    setBenchAddressing(DCC_ADDRESS_MODE_OUTPUT, 1, DCC_ADDRESS_SHIFT_NONE);
+    bootController.isDirty = true;
+    putSettings();
+    flushSettings();
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+    hostSerial.setMuted(false);
+
+    printf("failures %d\n", failures);
+    return failures ? 1 : 0;
+}
+
+/**
+ * @brief Signal aspect packets against a servo's aspect table
+ *
+ * Every aspect is sent to one servo as an extended accessory packet: aspects
+ * in the table must move the servo to their position, the others must leave
+ * it where it is. The table must survive a reboot, and dispatching an aspect
+ * packet is timed against a basic accessory packet.
+ */
+static int benchAspects() {
+    const uint8_t servo = 0;
+    const uint16_t address = BENCH_ADDRESS_BASE + servo;
+    const char *table = "0,25,-,75,100";
+    int failures = 0;
+
+    printf("\n== bench aspects: servo %u on address %u, table %s ==\n", servo, address, table);
+    printf("%-8s %8s %10s %8s %8s\n", "aspect", "percent", "expect deg", "deg", "result");
+
+    hostSerial.setMuted(true);
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+    {
+        ServoConfigLock lock;
+        parseServoAspects(table, virtualservo[servo].aspects);
+        refreshServoConfig();
+    }
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+
+    // Closed and thrown in degrees, as refreshServoConfig() works them out
+    const VIRTUALSERVO &vs = virtualservo[servo];
+    int closedDeg = SERVO_CENTER_POSITION + vs.offset + (vs.invert ? vs.swing : -vs.swing);
+    int thrownDeg = SERVO_CENTER_POSITION + vs.offset + (vs.invert ? -vs.swing : vs.swing);
+
+    uint8_t packet[4];
+    uint8_t heldAspect = 0;
+    for (uint8_t aspect = 0; aspect < SERVO_ASPECT_COUNT; aspect++) {
+        uint8_t percent = vs.aspects[aspect];
+        uint8_t positionBefore = vs.position;
+        Dcc.feed(packet, encodeAspectPacket(address, aspect, packet));
+        runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+
+        bool ok;
+        int expectDeg;
+        if (percent == SERVO_ASPECT_UNUSED) {
+            // Ignored: still holding the last aspect
+            expectDeg = positionBefore;
+            ok = vs.state == SERVO_ASPECT && getServoAspect(servo) == heldAspect && vs.position == positionBefore;
+        } else {
+            expectDeg = closedDeg + (thrownDeg - closedDeg) * percent / 100;
+            ok = vs.state == SERVO_ASPECT && getServoAspect(servo) == aspect && abs(vs.position - expectDeg) <= 1;
+            heldAspect = aspect;
+        }
+        if (!ok) failures++;
+        hostSerial.setMuted(false);
+        if (percent == SERVO_ASPECT_UNUSED) {
+            printf("%-8u %8s %10d %8u %8s\n", aspect, "-", expectDeg, vs.position, ok ? "ignored" : "FAIL");
+        } else {
+            printf("%-8u %8u %10d %8u %8s\n", aspect, percent, expectDeg, vs.position, ok ? "pass" : "FAIL");
+        }
+        hostSerial.setMuted(true);
+    }
+
+    // Dispatch cost: the same address stream as basic and as aspect packets
+    uint64_t basicNs = 0;
+    uint64_t aspectNs = 0;
+    for (uint32_t n = 0; n < BENCH_ASPECT_PACKETS; n++) {
+        uint32_t r = benchRandom();
+        uint16_t addr = BENCH_ADDRESS_BASE + r % (TOTAL_PINS * 8);  // One in eight is ours
+        uint64_t startNs = hostNowNs();
+        notifyDccAccTurnoutOutput(addr, (r >> 16) & 1, 1);
+        basicNs += hostNowNs() - startNs;
+        startNs = hostNowNs();
+        notifyDccSigOutputState(addr, (r >> 17) & 7);
+        aspectNs += hostNowNs() - startNs;
+        if ((n & 15) == 15) {
+            runStep();  // Keep the command queue drained
+        }
+    }
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+
+    // The table is a setting: it must come back after a reboot
+    bootController.isDirty = true;
+    putSettings();
+    flushSettings();
+    loadSettings();
+    hostSerial.setMuted(true);
+    char stored[SERVO_ASPECT_COUNT * 4 + 1];
+    formatServoAspects(virtualservo[servo].aspects, stored, sizeof(stored));
+    bool kept = strcmp(stored, table) == 0;
+    if (!kept) failures++;
+
+    // Back to the default table
+    {
+        ServoConfigLock lock;
+        setDefaultServoAspects(virtualservo[servo].aspects);
+        refreshServoConfig();
+    }
+    bootController.isDirty = true;
+    putSettings();
+    flushSettings();
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+    hostSerial.setMuted(false);
+
+    printf("dispatch: basic %.0f ns/packet, aspect %.0f ns/packet (host, %lu packets each)\n",
+           (double)basicNs / BENCH_ASPECT_PACKETS, (double)aspectNs / BENCH_ASPECT_PACKETS, BENCH_ASPECT_PACKETS);
+    printf("reboot: table %s%s\n", stored, kept ? "" : "  FAIL");
+    printf("failures %d\n", failures);
+    return failures ? 1 : 0;
+}
+
+static int runBench(const char *which) {
+    bool all = (which == nullptr);
+    if (!all && strcmp(which, "motion") && strcmp(which, "dispatch") && strcmp(which, "heap") && strcmp(which, "pages") &&
+        strcmp(which, "diag") && strcmp(which, "repeats") && strcmp(which, "addressing") && strcmp(which, "aspects") &&
+        strcmp(which, "journal") && strcmp(which, "layouts")) {
+        fprintf(stderr, "unknown benchmark '%s' (motion, dispatch, heap, pages, diag, repeats, addressing, aspects, journal, "
+                "layouts)\n", which);
+        return 2;
+    }
+
+    hostSerial.setMuted(true);
+    bootFirmware();
+    configureBenchServos();
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+    hostSerial.setMuted(false);
+
+    const ServoBootReport &boot = getServoBootReport();
+    printf("boot: %u servos in %u ms (virtual), %u skipped, %u thrown\n", boot.booted, boot.durationMs, boot.skipped,
+           boot.thrown);
+
+    if (all || !strcmp(which, "motion")) benchMotion();
+    int result = 0;
+    if (all || !strcmp(which, "dispatch")) result |= benchDispatch();
+    if (all || !strcmp(which, "heap")) benchHeap();
+    if (all || !strcmp(which, "pages")) benchPages();
+    if (all || !strcmp(which, "diag")) result |= benchDiag();
+    if (all || !strcmp(which, "repeats")) result |= benchRepeats();
+    if (all || !strcmp(which, "addressing")) result |= benchAddressing();
+    if (all || !strcmp(which, "aspects")) result |= benchAspects();
+    if (all || !strcmp(which, "journal")) result |= benchJournal();
+    if (all || !strcmp(which, "layouts")) result |= benchLayouts();  // Last: reloads the settings
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Replay
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Replay a capture downloaded from /dcc-capture
+ *
+ * Boots from the settings image in the capture, then feeds each packet to
+ * the decoder at its captured time on the virtual clock, so servo motion,
+ * move scheduling and state saves run as they did on the layout. The same
+ * capture always gives the same result.
+ * @return 0, 1 if the capture was truncated, 2 if it could not be read
+ */
+static int runReplay(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "replay: cannot open %s\n", path);
+        return 2;
+    }
+    std::vector<uint8_t> capture;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        capture.insert(capture.end(), chunk, chunk + n);
+    }
+    fclose(file);
+
+    DccCaptureHeader header;
+    if (capture.size() < sizeof(header)) {
+        fprintf(stderr, "replay: %s is not a DCC capture\n", path);
+        return 2;
+    }
+    memcpy(&header, capture.data(), sizeof(header));
+    if (header.magic != DCC_CAPTURE_MAGIC || header.version != DCC_CAPTURE_VERSION ||
+        header.recordSize != sizeof(DccCaptureRecord) || header.settingsSize > capture.size() - sizeof(header)) {
+        fprintf(stderr, "replay: %s is not a version %d DCC capture\n", path, DCC_CAPTURE_VERSION);
+        return 2;
+    }
+    const uint8_t *settings = capture.data() + sizeof(header);
+    const uint8_t *records = settings + header.settingsSize;
+    uint32_t available = (capture.size() - sizeof(header) - header.settingsSize) / sizeof(DccCaptureRecord);
+    uint32_t count = header.recordCount < available ? header.recordCount : available;
+
+    // The settings the layout had, as if read from flash at boot
+    memcpy(EEPROM.getDataPtr(), settings, header.settingsSize < EEPROM_SIZE ? header.settingsSize : EEPROM_SIZE);
+    hostSerial.setMuted(true);
+    bootFirmware();
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+
+    uint32_t accessory = 0, ours = 0, rejected = 0;
+    uint64_t decodeNs = 0;
+    uint64_t startUs = hostClock.getMicros();
+    uint64_t offsetUs = 0;
+    uint32_t previousUs = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        DccCaptureRecord record;
+        memcpy(&record, records + i * sizeof(record), sizeof(record));
+        if (i > 0) offsetUs += (uint32_t)(record.timestampUs - previousUs);  // micros() wraps
+        previousUs = record.timestampUs;
+        while (hostClock.getMicros() < startUs + offsetUs) {
+            runStep();
+        }
+
+        uint16_t address = accessoryAddress(record.data, record.size);
+        if (address != 0) {
+            accessory++;
+            if (dccAddressIndex.lookup(dccAddressIndex.toStationAddress(address)) != 0) ours++;
+        }
+        uint64_t beginNs = hostNowNs();
+        if (!Dcc.feed(record.data, record.size)) rejected++;
+        decodeNs += hostNowNs() - beginNs;
+    }
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+    hostSerial.setMuted(false);
+
+    printf("== replay %s: %u packets over %.3f s, %u idle not captured, %u lost while capturing ==\n", path, count,
+           offsetUs / 1e6, header.idle, header.lost);
+    if (count < header.recordCount) {
+        printf("truncated: %u of %u packets present\n", count, header.recordCount);
+    }
+    printf("accessory: %u packets, %u for our servos, %u rejected by the decoder\n", accessory, ours, rejected);
+    printf("decode: %.0f ns/packet (host)\n", count ? (double)decodeNs / count : 0.0);
+    for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+        const VIRTUALSERVO &servo = virtualservo[i];
+        if (servo.address == 0) continue;
+        if (servo.state == SERVO_ASPECT) {
+            printf("servo %2u (address %4u): aspect %u, %u deg\n", i, servo.address, getServoAspect(i), servo.position);
+            continue;
+        }
+        printf("servo %2u (address %4u): %s, %u deg\n", i, servo.address,
+               servo.state == SERVO_THROWN ? "thrown" : servo.state == SERVO_CLOSED ? "closed" : "moving", servo.position);
+    }
+    return count < header.recordCount ? 1 : 0;
+}
+
+// ---------------------------------------------------------------------------
+// Interactive
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Save the /dcc-capture download to a file
+ */
+static void saveCapture(const char *path) {
+    hostWebServer.resetResponse(true);
+    dccCapture.send(hostWebServer);
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr) {
+        printf("harness: cannot write %s\n", path);
+        return;
+    }
+    fwrite(hostWebServer.getCaptured().data(), 1, hostWebServer.getCaptured().size(), file);
+    fclose(file);
+    printf("harness: %u packets saved to %s\n", dccCapture.getRecordCount(), path);
+}
+
+static void printPage(const char *path) {
+    for (const HostPage &hostPage : hostPages) {
+        if (strcmp(hostPage.path, path) == 0) {
+            hostWebServer.resetResponse(true);
+            hostPage.send(hostWebServer);
+            fwrite(hostWebServer.getCaptured().data(), 1, hostWebServer.getCaptured().size(), stdout);
+            printf("\n");
+            return;
+        }
+    }
+    printf("harness: no page %s\n", path);
+}
+
+static void runHarnessCommand(const std::string &line) {
+    unsigned addr, dir, ms;
+    char path[32];
+
+    if (sscanf(line.c_str(), "@dcc %u,%u", &addr, &dir) == 2) {
+        uint8_t packet[3];
+        Dcc.feed(packet, encodeAccessoryPacket(addr, dir, 1, packet));
+        runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+    } else if (sscanf(line.c_str(), "@aspect %u,%u", &addr, &dir) == 2) {
+        uint8_t packet[4];
+        Dcc.feed(packet, encodeAspectPacket(addr, dir, packet));
+        runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+    } else if (sscanf(line.c_str(), "@wait %u", &ms) == 1) {
+        runForMs(ms);
+    } else if (line == "@time") {
+        printf("time: %llu.%03llu ms\n", (unsigned long long)hostClock.getMillis(),
+               (unsigned long long)(hostClock.getMicros() % 1000));
+    } else if (line == "@heap") {
+        printHeap();
+    } else if (sscanf(line.c_str(), "@page %31s", path) == 1) {
+        printPage(path);
+    } else if (sscanf(line.c_str(), "@capture %31s", path) == 1) {
+        saveCapture(path);
+    } else {
+        printf("harness: @dcc addr,dir | @aspect addr,n | @wait ms | @time | @heap | @page path | @capture file\n");
+    }
+}
+
+static int runInteractive() {
+    bootFirmware();
+    runUntilIdle(HOST_IDLE_TIMEOUT_MS);
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (!line.empty() && line[0] == '@') {
+            runHarnessCommand(line);
+        } else {
+            hostSerial.feed((line + "\n").c_str());
+            if (!runUntilIdle(HOST_IDLE_TIMEOUT_MS)) {
+                printf("[host] servos still moving after %d ms\n", HOST_IDLE_TIMEOUT_MS);
+            }
+        }
+        fflush(stdout);
+    }
+
+    // Let settings still waiting for their commit be written, as on the layout
+    while (eepromWriter.isPending()) {
+        runStep();
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 2 && !strcmp(argv[1], "bench")) {
+        return runBench(argc >= 3 ? argv[2] : nullptr);
+    }
+    if (argc >= 3 && !strcmp(argv[1], "replay")) {
+        return runReplay(argv[2]);
+    }
+    return runInteractive();
+}
@@ -0,0 +1,272 @@
+#include "host_runtime.h"
+#include <EEPROM.h>
+#include <esp_partition.h>
+#include "../config.h"
+#include <ESPmDNS.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <chrono>
+#include <cstddef>
+#include <new>
+
+// Global instances
+HostClock hostClock;
+HostHeap hostHeap;
+HostSerial hostSerial;
+HostFlash hostFlash;
+
+HardwareSerial Serial;
+EspClass ESP;
+EEPROMClass EEPROM;
+WiFiClass WiFi;
+MDNSResponder MDNS;
+LittleFSFS LittleFS;
+
+// ---------------------------------------------------------------------------
+// Heap accounting. Each block carries its size in a header so delete can
+// account for it; max_align_t keeps the returned pointer suitably aligned.
+// ---------------------------------------------------------------------------
+
+void HostHeap::recordAlloc(size_t size) {
+    inUse += size;
+    bytesAllocated += size;
+    allocations++;
+    if (inUse > peak) peak = inUse;
+}
+
+void HostHeap::recordFree(size_t size) {
+    inUse -= size;
+    frees++;
+}
+
+static void *hostAlloc(size_t size) {
+    void *block = malloc(sizeof(std::max_align_t) + size);
+    if (block == nullptr) throw std::bad_alloc();
+    *static_cast<size_t *>(block) = size;
+    hostHeap.recordAlloc(size);
+    return static_cast<char *>(block) + sizeof(std::max_align_t);
+}
+
+static void hostFree(void *ptr) {
+    if (ptr == nullptr) return;
+    void *block = static_cast<char *>(ptr) - sizeof(std::max_align_t);
+    hostHeap.recordFree(*static_cast<size_t *>(block));
+    free(block);
+}
+
+void *operator new(size_t size) { return hostAlloc(size); }
+void *operator new[](size_t size) { return hostAlloc(size); }
+void operator delete(void *ptr) noexcept { hostFree(ptr); }
+void operator delete[](void *ptr) noexcept { hostFree(ptr); }
+void operator delete(void *ptr, size_t) noexcept { hostFree(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { hostFree(ptr); }
+
+// ---------------------------------------------------------------------------
+// Time and GPIO
+// ---------------------------------------------------------------------------
+
+unsigned long millis() { return (unsigned long)(uint32_t)hostClock.getMillis(); }
+unsigned long micros() { return (unsigned long)(uint32_t)hostClock.getMicros(); }
+void delay(uint32_t ms) { hostClock.advanceMs(ms); }
+void delayMicroseconds(uint32_t us) { hostClock.advanceUs(us); }
+void yield() {}
+
+static uint8_t pinLevel[64];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    // Inputs idle high, as with the pull-ups used on the board
+    if (pin < sizeof(pinLevel) && mode != OUTPUT) pinLevel[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    if (pin < sizeof(pinLevel)) pinLevel[pin] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < sizeof(pinLevel) ? pinLevel[pin] : LOW;
+}
+
+// ---------------------------------------------------------------------------
+// Serial
+// ---------------------------------------------------------------------------
+
+void HostSerial::feed(const char *text) {
+    if (readPos == input.size()) {
+        input.clear();
+        readPos = 0;
+    }
+    input += text;
+}
+
+int HostSerial::read() {
+    if (!available()) return -1;
+    return (uint8_t)input[readPos++];
+}
+
+void HardwareSerial::begin(unsigned long baud) { (void)baud; }
+int HardwareSerial::available() { return hostSerial.available(); }
+int HardwareSerial::read() { return hostSerial.read(); }
+int HardwareSerial::peek() { return hostSerial.peek(); }
+void HardwareSerial::flush() { fflush(stdout); }
+
+size_t HardwareSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+    hostSerial.countWritten(size);
+    if (!hostSerial.isMuted()) fwrite(buffer, 1, size, stdout);
+    return size;
+}
+
+// ---------------------------------------------------------------------------
+// Chip
+// ---------------------------------------------------------------------------
+
+uint32_t EspClass::getFreeHeap() { return HOST_HEAP_SIZE - hostHeap.getInUse(); }
+uint32_t EspClass::getMinFreeHeap() { return HOST_HEAP_SIZE - hostHeap.getPeak(); }
+uint32_t EspClass::getHeapSize() { return HOST_HEAP_SIZE; }
+
+uint32_t EspClass::getCycleCount() {
+    // Host time in 240 MHz cycles. Real cost, so not part of the deterministic clock
+    using namespace std::chrono;
+    uint64_t ns = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    return (uint32_t)(ns * 240 / 1000);
+}
+
+void EspClass::restart() {
+    Serial.println("[host] ESP.restart()");
+    fflush(stdout);
+    exit(0);
+}
+
+EEPROMClass::EEPROMClass() : size(0), commits(0) {
+    erase();
+}
+
+bool EEPROMClass::begin(size_t requested) {
+    if (requested > HOST_EEPROM_CAPACITY) return false;
+    size = requested;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// WiFi driver and FreeRTOS
+// ---------------------------------------------------------------------------
+
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t *conf) {
+    (void)interface;
+    memset(conf, 0, sizeof(*conf));
+    conf->ap.channel = 1;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t *ap_info) {
+    (void)ap_info;
+    return ESP_FAIL;
+}
+
+static int hostTaskHandle;
+static int hostMutex;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name, uint32_t stackDepth, void *param,
+                                   UBaseType_t priority, TaskHandle_t *createdTask, BaseType_t coreId) {
+    (void)task; (void)name; (void)stackDepth; (void)param; (void)priority; (void)coreId;
+    if (createdTask != nullptr) *createdTask = &hostTaskHandle;
+    return pdPASS;
+}
+
+TickType_t xTaskGetTickCount() { return (TickType_t)hostClock.getMillis(); }
+void vTaskDelay(TickType_t ticks) { hostClock.advanceMs(ticks); }
+
+void vTaskDelayUntil(TickType_t *previousWakeTime, TickType_t timeIncrement) {
+    *previousWakeTime += timeIncrement;
+    TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(*previousWakeTime - now) > 0) hostClock.advanceMs(*previousWakeTime - now);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return &hostMutex; }
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait) { (void)semaphore; (void)ticksToWait; return pdTRUE; }
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) { (void)semaphore; return pdTRUE; }
+
+// ---------------------------------------------------------------------------
+// Flash
+// ---------------------------------------------------------------------------
+
+HostFlash::HostFlash() : budget(-1), failCalls(0), powerLost(false), operations(0), erases(0) {
+    memset(data, 0xFF, sizeof(data));
+}
+
+bool HostFlash::read(size_t offset, void *dst, size_t size) const {
+    if (offset + size > sizeof(data)) return false;
+    memcpy(dst, data + offset, size);
+    return true;
+}
+
+bool HostFlash::write(size_t offset, const void *src, size_t size) {
+    if (offset + size > sizeof(data)) return false;
+    if (failCalls > 0) { failCalls--; return false; }
+    const uint8_t *bytes = static_cast<const uint8_t *>(src);
+    for (size_t i = 0; i < size && !powerLost; i++) {
+        if (budget == 0) { powerLost = true; break; }
+        if (budget > 0) budget--;
+        data[offset + i] &= bytes[i];
+        operations++;
+    }
+    return true;  // After a power cut the firmware would not be running to see an error
+}
+
+bool HostFlash::erase(size_t offset, size_t size) {
+    if (offset + size > sizeof(data)) return false;
+    if (failCalls > 0) { failCalls--; return false; }
+    if (powerLost) return true;
+    if (budget == 0) {
+        memset(data + offset, 0xFF, size / 2);
+        powerLost = true;
+        return true;
+    }
+    if (budget > 0) budget--;
+    memset(data + offset, 0xFF, size);
+    operations++;
+    erases++;
+    return true;
+}
+
+// The data partitions of partitions.csv that the firmware opens
+static const esp_partition_t hostPartitions[] = {
+    {ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)0x41, 0x3DE000, 0x2000, SERVO_STATE_PARTITION, false},
+    {ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)0x40, 0x3E0000, 0x10000, CONFIG_JOURNAL_PARTITION, false},
+};
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char *label) {
+    (void)subtype;
+    for (const esp_partition_t &partition : hostPartitions) {
+        if (type == partition.type && label != nullptr && strcmp(label, partition.label) == 0) {
+            return &partition;
+        }
+    }
+    return nullptr;
+}
+
+static bool hostFlashRange(const esp_partition_t *partition, size_t offset, size_t size, size_t &flashOffset) {
+    if (offset + size > partition->size) return false;
+    flashOffset = partition->address - HOST_FLASH_BASE + offset;
+    return true;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size) {
+    size_t offset;
+    return (hostFlashRange(partition, src_offset, size, offset) && hostFlash.read(offset, dst, size)) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *partition, size_t dst_offset, const void *src, size_t size) {
+    size_t offset;
+    return (hostFlashRange(partition, dst_offset, size, offset) && hostFlash.write(offset, src, size)) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition, size_t offset, size_t size) {
+    size_t flashOffset;
+    return (hostFlashRange(partition, offset, size, flashOffset) && hostFlash.erase(flashOffset, size)) ? ESP_OK : ESP_FAIL;
+}
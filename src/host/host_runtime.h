@@ -0,0 +1,128 @@
+#ifndef HOST_RUNTIME_H
+#define HOST_RUNTIME_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Deterministic virtual clock behind millis(), micros() and delay()
+ * 
+ * Time only moves when the harness (or a delay() in firmware code) advances
+ * it, so the same script always produces the same servo motion.
+ */
+class HostClock {
+private:
+    uint64_t nowUs;
+
+public:
+    constexpr HostClock() : nowUs(0) {}
+
+    uint64_t getMicros() const { return nowUs; }
+    uint64_t getMillis() const { return nowUs / 1000; }
+    void advanceUs(uint64_t us) { nowUs += us; }
+    void advanceMs(uint32_t ms) { nowUs += (uint64_t)ms * 1000; }
+    void reset() { nowUs = 0; }
+};
+
+/**
+ * @brief Heap accounting from the global operator new/delete hooks
+ * 
+ * ESP.getFreeHeap() reports HOST_HEAP_SIZE minus what is in use here, so
+ * firmware code that prints heap figures shows host allocations.
+ */
+#define HOST_HEAP_SIZE (320UL * 1024UL)
+
+class HostHeap {
+private:
+    size_t inUse;
+    size_t peak;
+    uint64_t bytesAllocated;
+    uint32_t allocations;
+    uint32_t frees;
+
+public:
+    constexpr HostHeap() : inUse(0), peak(0), bytesAllocated(0), allocations(0), frees(0) {}
+
+    void recordAlloc(size_t size);
+    void recordFree(size_t size);
+    void resetPeak() { peak = inUse; }
+
+    size_t getInUse() const { return inUse; }
+    size_t getPeak() const { return peak; }
+    uint64_t getBytesAllocated() const { return bytesAllocated; }
+    uint32_t getAllocations() const { return allocations; }
+    uint32_t getFrees() const { return frees; }
+};
+
+/**
+ * @brief Controls for the host Serial port
+ * 
+ * Input is queued with feed() and read back by the firmware's serial parser.
+ * Output goes to stdout unless muted; bytes are counted either way.
+ */
+class HostSerial {
+private:
+    std::string input;
+    size_t readPos;
+    bool muted;
+    uint64_t bytesWritten;
+
+public:
+    HostSerial() : readPos(0), muted(false), bytesWritten(0) {}
+
+    void feed(const char *text);
+    int available() const { return (int)(input.size() - readPos); }
+    int peek() const { return available() ? (uint8_t)input[readPos] : -1; }
+    int read();
+
+    void setMuted(bool mute) { muted = mute; }
+    bool isMuted() const { return muted; }
+    void countWritten(size_t n) { bytesWritten += n; }
+    uint64_t getBytesWritten() const { return bytesWritten; }
+};
+
+/**
+ * @brief NOR flash behind the servo state log and settings journal partitions
+ * 
+ * Erasing sets bytes to 0xFF; writing can only clear bits, as on the chip.
+ * For power-loss tests the harness can cut the power after a number of
+ * flash operations (one per byte written, one per erase): the cut lands
+ * part way through a write, and an erase cut short leaves half the range
+ * untouched. After the cut nothing more reaches the flash. It can also
+ * refuse the next write or erase calls, as a flash error would.
+ */
+#define HOST_FLASH_BASE 0x3DE000UL     // Flash address of the first partition (partitions.csv)
+#define HOST_FLASH_SIZE (72UL * 1024UL)
+
+class HostFlash {
+private:
+    uint8_t data[HOST_FLASH_SIZE];
+    int64_t budget;         // Operations left before the power cut, -1 = no cut
+    uint32_t failCalls;     // Write/erase calls still to be refused with an error
+    bool powerLost;
+    uint64_t operations;
+    uint32_t erases;
+
+public:
+    HostFlash();
+
+    bool read(size_t offset, void *dst, size_t size) const;
+    bool write(size_t offset, const void *src, size_t size);
+    bool erase(size_t offset, size_t size);
+
+    // Harness side
+    void cutPowerAfter(int64_t count) { budget = count; powerLost = false; }
+    void restorePower() { budget = -1; powerLost = false; }
+    void failNextCalls(uint32_t count) { failCalls = count; }  // Refused without touching the flash
+    bool isPowerLost() const { return powerLost; }
+    uint64_t getOperations() const { return operations; }
+    uint32_t getEraseCount() const { return erases; }
+    void save(uint8_t *copy) const { memcpy(copy, data, sizeof(data)); }
+    void load(const uint8_t *copy) { memcpy(data, copy, sizeof(data)); }
+};
+
+extern HostClock hostClock;
+extern HostHeap hostHeap;
+extern HostSerial hostSerial;
+extern HostFlash hostFlash;
+
+#endif // HOST_RUNTIME_H
@@ -0,0 +1,61 @@
+#include <Arduino.h>
+#include "../wifi_controller.h"
+#include "../utils/dcc_debug_logger.h"
+
+/*
+ * Stand-ins for the pieces of main.cpp, core/system_manager.cpp and
+ * wifi_controller.cpp that the modules in the host build call into.
+ * There is no radio and no LED, so these keep the configuration the
+ * firmware would act on and report what they would have done.
+ */
+
+WiFiConfig wifiConfig;
+
+void triggerDccSignal() {
+    dccDebugLogger.logSignal();
+}
+
+void toggleDccDebug() {
+    dccDebugLogger.toggleDebug();
+}
+
+String getMacAddress() {
+    return WiFi.macAddress();
+}
+
+String getMDNSHostname() {
+    if (strlen(wifiConfig.hostname) > 0) {
+        return String(wifiConfig.hostname);
+    }
+    return "dccservo";
+}
+
+void generateDefaultCredentials() {
+    String macSuffix = WiFi.macAddress();
+    macSuffix.replace(":", "");
+    macSuffix = macSuffix.substring(macSuffix.length() - 6);
+    macSuffix.toLowerCase();
+    
+    snprintf(wifiConfig.apSSID, WIFI_SSID_MAX_LENGTH, "DCCAC_%s", macSuffix.c_str());
+    snprintf(wifiConfig.apPassword, WIFI_PASSWORD_MAX_LENGTH, "PASS_%s", macSuffix.c_str());
+}
+
+void initializeWiFi() {
+    WiFi.mode(wifiConfig.enabled && wifiConfig.mode == DCC_WIFI_AP ? WIFI_AP :
+              wifiConfig.enabled && wifiConfig.mode == DCC_WIFI_STATION ? WIFI_STA : WIFI_OFF);
+    Serial.printf("[host] WiFi not available (configured mode %d)\n", wifiConfig.mode);
+}
+
+void setupMDNS() {
+    Serial.printf("[host] mDNS not available (%s.local)\n", getMDNSHostname().c_str());
+}
+
+void printWiFiStatus() {
+    Serial.println("=== WiFi Status ===");
+    Serial.printf("Mode: %d\n", wifiConfig.mode);
+    Serial.printf("Enabled: %s\n", wifiConfig.enabled ? "Yes" : "No");
+    Serial.println("[host] no radio");
+    Serial.printf("MAC Address: %s\n", getMacAddress().c_str());
+    Serial.printf("mDNS Hostname: %s.local\n", getMDNSHostname().c_str());
+    Serial.println("==================");
+}
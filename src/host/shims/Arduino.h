@@ -0,0 +1,252 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/**
+ * @brief Host stand-in for the Arduino core
+ * 
+ * Just enough of the ESP32 Arduino API for the servo engine, DCC handler,
+ * EEPROM manager, serial commands and debug logger to compile and run on a
+ * Linux box. Time comes from the virtual clock in host_runtime.h, so nothing
+ * advances unless the harness advances it.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <algorithm>
+
+#define HEX 16
+#define DEC 10
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define PROGMEM
+#define PGM_P const char *
+#define strlen_P strlen
+#define memcpy_P memcpy
+#define F(x) (x)
+#define IRAM_ATTR
+#define RTC_NOINIT_ATTR
+
+using std::abs;
+using std::min;
+using std::max;
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+
+/**
+ * @brief Arduino String over std::string
+ */
+class String {
+private:
+    std::string s;
+
+    static std::string fromNumber(const char *fmt, long long value) {
+        char buf[34];
+        snprintf(buf, sizeof(buf), fmt, value);
+        return buf;
+    }
+    static std::string fromUnsigned(unsigned long long value, int base) {
+        char buf[66];
+        if (base == 16) snprintf(buf, sizeof(buf), "%llx", value);
+        else if (base == 2) {
+            int n = 0;
+            char tmp[65];
+            do { tmp[n++] = '0' + (value & 1); value >>= 1; } while (value);
+            for (int i = 0; i < n; i++) buf[i] = tmp[n - 1 - i];
+            buf[n] = '\0';
+        } else snprintf(buf, sizeof(buf), "%llu", value);
+        return buf;
+    }
+
+public:
+    String() {}
+    String(const char *cstr) : s(cstr ? cstr : "") {}
+    String(const std::string &str) : s(str) {}
+    explicit String(char c) : s(1, c) {}
+    String(unsigned char value, unsigned char base = 10) : s(fromUnsigned(value, base)) {}
+    String(int value, unsigned char base = 10)
+        : s(base == 10 ? fromNumber("%lld", value) : fromUnsigned((unsigned)value, base)) {}
+    String(unsigned int value, unsigned char base = 10) : s(fromUnsigned(value, base)) {}
+    String(long value, unsigned char base = 10)
+        : s(base == 10 ? fromNumber("%lld", value) : fromUnsigned((unsigned long)value, base)) {}
+    String(unsigned long value, unsigned char base = 10) : s(fromUnsigned(value, base)) {}
+    String(float value, unsigned char decimalPlaces = 2) : String((double)value, decimalPlaces) {}
+    String(double value, unsigned char decimalPlaces = 2) {
+        char buf[40];
+        snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+        s = buf;
+    }
+
+    const char *c_str() const { return s.c_str(); }
+    unsigned int length() const { return s.size(); }
+    bool reserve(unsigned int size) { s.reserve(size); return true; }
+    bool isEmpty() const { return s.empty(); }
+
+    String &operator+=(const String &rhs) { s += rhs.s; return *this; }
+    String &operator+=(const char *rhs) { s += rhs; return *this; }
+    String &operator+=(char rhs) { s += rhs; return *this; }
+    template <typename T> String &operator+=(T rhs) { s += String(rhs).s; return *this; }
+    bool concat(const String &rhs) { s += rhs.s; return true; }
+    bool concat(const char *rhs) { s += rhs; return true; }
+    bool concat(const char *rhs, unsigned int len) { s.append(rhs, len); return true; }
+    bool concat(char rhs) { s += rhs; return true; }
+
+    char &operator[](unsigned int index) { return s[index]; }
+    char operator[](unsigned int index) const { return index < s.size() ? s[index] : 0; }
+    char charAt(unsigned int index) const { return index < s.size() ? s[index] : 0; }
+
+    bool operator==(const String &rhs) const { return s == rhs.s; }
+    bool operator!=(const String &rhs) const { return s != rhs.s; }
+    bool operator==(const char *rhs) const { return s == rhs; }
+    bool operator!=(const char *rhs) const { return s != rhs; }
+    bool equals(const String &rhs) const { return s == rhs.s; }
+    bool equalsIgnoreCase(const String &rhs) const {
+        return s.size() == rhs.s.size() &&
+               std::equal(s.begin(), s.end(), rhs.s.begin(),
+                          [](char a, char b) { return tolower(a) == tolower(b); });
+    }
+
+    int indexOf(char ch, unsigned int from = 0) const { return find(s.find(ch, from)); }
+    int indexOf(const char *str, unsigned int from = 0) const { return find(s.find(str, from)); }
+    int indexOf(const String &str, unsigned int from = 0) const { return find(s.find(str.s, from)); }
+    int lastIndexOf(char ch) const { return find(s.rfind(ch)); }
+    bool startsWith(const String &prefix) const { return s.rfind(prefix.s, 0) == 0; }
+    bool endsWith(const String &suffix) const {
+        return s.size() >= suffix.s.size() && s.compare(s.size() - suffix.s.size(), suffix.s.size(), suffix.s) == 0;
+    }
+
+    String substring(unsigned int from) const { return from > s.size() ? String() : String(s.substr(from)); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        return from > s.size() ? String() : String(s.substr(from, to - from));
+    }
+
+    void replace(const String &find, const String &replace) {
+        if (find.s.empty()) return;
+        size_t pos = 0;
+        while ((pos = s.find(find.s, pos)) != std::string::npos) {
+            s.replace(pos, find.s.size(), replace.s);
+            pos += replace.s.size();
+        }
+    }
+    void remove(unsigned int index) { if (index < s.size()) s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < s.size()) s.erase(index, count); }
+    void trim() {
+        size_t first = s.find_first_not_of(" \t\r\n");
+        size_t last = s.find_last_not_of(" \t\r\n");
+        s = (first == std::string::npos) ? "" : s.substr(first, last - first + 1);
+    }
+    void toLowerCase() { for (auto &c : s) c = tolower(c); }
+    void toUpperCase() { for (auto &c : s) c = toupper(c); }
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return atof(s.c_str()); }
+
+private:
+    static int find(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+};
+
+inline String operator+(const String &lhs, const String &rhs) { String r(lhs); r += rhs; return r; }
+inline String operator+(const String &lhs, const char *rhs) { String r(lhs); r += rhs; return r; }
+inline String operator+(const char *lhs, const String &rhs) { String r(lhs); r += rhs; return r; }
+inline String operator+(const String &lhs, char rhs) { String r(lhs); r += rhs; return r; }
+
+/**
+ * @brief Arduino Print, formatting everything into write(uint8_t)
+ */
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+    size_t print(const char *str) { return write(str); }
+    size_t print(const String &str) { return write(str.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = DEC) { return print(String(value, base)); }
+    size_t print(int value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned int value, int base = DEC) { return print(String(value, base)); }
+    size_t print(long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(double value, int digits = 2) { return print(String(value, digits)); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(const T &value) { size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(const T &value, int format) { size_t n = print(value, format); return n + println(); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[512];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        if (len < 0) return 0;
+        if ((size_t)len < sizeof(buf)) return write((const uint8_t *)buf, len);
+
+        std::string big(len + 1, '\0');
+        va_start(args, format);
+        vsnprintf(&big[0], big.size(), format, args);
+        va_end(args);
+        return write((const uint8_t *)big.data(), len);
+    }
+};
+
+/**
+ * @brief Serial port backed by stdout and an injectable input buffer
+ */
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud);
+    void end() {}
+    int available();
+    int read();
+    int peek();
+    int availableForWrite() { return 256; }
+    void flush();
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * @brief Chip information, with heap figures from the host allocator hooks
+ */
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return 240; }
+    [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
+
+#endif // HOST_ARDUINO_H
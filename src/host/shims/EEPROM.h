@@ -0,0 +1,46 @@
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <Arduino.h>
+
+#define HOST_EEPROM_CAPACITY 4096
+
+/**
+ * @brief RAM-backed EEPROM emulation
+ * 
+ * Starts erased (0xFF) like fresh flash. Commits are counted so the
+ * harness can see how often settings are written back.
+ */
+class EEPROMClass {
+private:
+    uint8_t data[HOST_EEPROM_CAPACITY];
+    size_t size;
+    uint32_t commits;
+
+public:
+    EEPROMClass();
+    bool begin(size_t size);
+    void end() {}
+    uint8_t read(int address) { return (address >= 0 && (size_t)address < size) ? data[address] : 0; }
+    void write(int address, uint8_t value) { if (address >= 0 && (size_t)address < size) data[address] = value; }
+    bool commit() { commits++; return true; }
+    uint8_t *getDataPtr() { return data; }
+    size_t length() const { return size; }
+
+    template <typename T> T &get(int address, T &t) {
+        if (address >= 0 && address + sizeof(T) <= size) memcpy((void *)&t, data + address, sizeof(T));
+        return t;
+    }
+    template <typename T> const T &put(int address, const T &t) {
+        if (address >= 0 && address + sizeof(T) <= size) memcpy(data + address, (const void *)&t, sizeof(T));
+        return t;
+    }
+
+    // Host-only
+    uint32_t getCommitCount() const { return commits; }
+    void erase() { memset(data, 0xFF, sizeof(data)); }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
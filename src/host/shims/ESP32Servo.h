@@ -0,0 +1,47 @@
+#ifndef HOST_ESP32SERVO_H
+#define HOST_ESP32SERVO_H
+
+#include <Arduino.h>
+
+#define DEFAULT_uS_LOW 544
+#define DEFAULT_uS_HIGH 2400
+
+/**
+ * @brief Host stand-in for the ESP32Servo PWM timer allocator
+ */
+class ESP32PWM {
+public:
+    static void allocateTimer(int timerNumber) { (void)timerNumber; }
+};
+
+/**
+ * @brief Host servo that records its pulse width instead of driving a pin
+ * 
+ * The harness reads pin, pulse and write counts back to check motion timing.
+ */
+class Servo {
+private:
+    int pin = -1;
+    int pulseUs = 0;
+    uint32_t writes = 0;
+
+public:
+    int attach(int pinNumber) { pin = pinNumber; return 1; }
+    int attach(int pinNumber, int minUs, int maxUs) { (void)minUs; (void)maxUs; return attach(pinNumber); }
+    void detach() { pin = -1; }
+    bool attached() const { return pin >= 0; }
+    void write(int angle) {
+        if (angle < 0) angle = 0;
+        if (angle > 180) angle = 180;
+        writeMicroseconds(DEFAULT_uS_LOW + (long)angle * (DEFAULT_uS_HIGH - DEFAULT_uS_LOW) / 180);
+    }
+    void writeMicroseconds(int us) { pulseUs = us; writes++; }
+    int readMicroseconds() const { return pulseUs; }
+    int read() const { return (long)(pulseUs - DEFAULT_uS_LOW) * 180 / (DEFAULT_uS_HIGH - DEFAULT_uS_LOW); }
+
+    // Host-only inspection
+    int attachedPin() const { return pin; }
+    uint32_t writeCount() const { return writes; }
+};
+
+#endif // HOST_ESP32SERVO_H
@@ -0,0 +1,20 @@
+#ifndef HOST_ESPMDNS_H
+#define HOST_ESPMDNS_H
+
+#include "WiFi.h"
+
+/**
+ * @brief mDNS responder that never resolves anything
+ */
+class MDNSResponder {
+public:
+    bool begin(const char *hostName) { (void)hostName; return true; }
+    void end() {}
+    bool addService(const char *service, const char *proto, uint16_t port) { (void)service; (void)proto; (void)port; return true; }
+    IPAddress queryHost(const char *host, uint32_t timeout = 2000) { (void)host; (void)timeout; return IPAddress(); }
+    IPAddress queryHost(const String &host, uint32_t timeout = 2000) { return queryHost(host.c_str(), timeout); }
+};
+
+extern MDNSResponder MDNS;
+
+#endif // HOST_ESPMDNS_H
@@ -0,0 +1,73 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * File system on the host: files are kept in memory for the life of the
+ * process (LittleFS in LittleFS.h is the only instance).
+ */
+
+namespace fs {
+
+class File {
+private:
+    std::shared_ptr<std::vector<uint8_t>> data;
+    size_t position = 0;
+
+public:
+    File() {}
+    File(std::shared_ptr<std::vector<uint8_t>> contents, size_t start) : data(contents), position(start) {}
+
+    size_t write(const uint8_t *buffer, size_t size) {
+        if (!data) return 0;
+        if (position + size > data->size()) data->resize(position + size);
+        memcpy(data->data() + position, buffer, size);
+        position += size;
+        return size;
+    }
+    size_t read(uint8_t *buffer, size_t size) {
+        if (!data || position >= data->size()) return 0;
+        if (size > data->size() - position) size = data->size() - position;
+        memcpy(buffer, data->data() + position, size);
+        position += size;
+        return size;
+    }
+    size_t size() const { return data ? data->size() : 0; }
+    void flush() {}
+    void close() { data.reset(); }
+    operator bool() const { return (bool)data; }
+};
+
+class FS {
+private:
+    std::map<std::string, std::shared_ptr<std::vector<uint8_t>>> files;
+
+public:
+    /**
+     * @brief Open a file: "r" (must exist), "w" (truncated) or "a"
+     */
+    File open(const char *path, const char *mode = "r") {
+        auto found = files.find(path);
+        if (mode[0] == 'w' || (mode[0] == 'a' && found == files.end())) {
+            auto contents = std::make_shared<std::vector<uint8_t>>();
+            files[path] = contents;
+            return File(contents, 0);
+        }
+        if (found == files.end()) return File();
+        return File(found->second, mode[0] == 'a' ? found->second->size() : 0);
+    }
+    bool exists(const char *path) const { return files.count(path) != 0; }
+    bool remove(const char *path) { return files.erase(path) != 0; }
+};
+
+} // namespace fs
+
+using fs::FS;
+using fs::File;
+
+#endif // HOST_FS_H
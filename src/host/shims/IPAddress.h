@@ -0,0 +1,43 @@
+#ifndef HOST_IPADDRESS_H
+#define HOST_IPADDRESS_H
+
+#include <Arduino.h>
+
+/**
+ * @brief IPv4 address, stored in network byte order like the ESP32 core
+ */
+class IPAddress {
+private:
+    uint8_t bytes[4] = {0, 0, 0, 0};
+
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) { bytes[0] = a; bytes[1] = b; bytes[2] = c; bytes[3] = d; }
+    IPAddress(uint32_t address) { memcpy(bytes, &address, 4); }
+
+    operator uint32_t() const { uint32_t v; memcpy(&v, bytes, 4); return v; }
+    bool operator==(const IPAddress &rhs) const { return memcmp(bytes, rhs.bytes, 4) == 0; }
+    bool operator!=(const IPAddress &rhs) const { return !(*this == rhs); }
+    uint8_t operator[](int index) const { return bytes[index]; }
+    uint8_t &operator[](int index) { return bytes[index]; }
+
+    bool fromString(const char *address) {
+        unsigned a, b, c, d;
+        char tail;
+        if (sscanf(address, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4) return false;
+        if (a > 255 || b > 255 || c > 255 || d > 255) return false;
+        *this = IPAddress(a, b, c, d);
+        return true;
+    }
+    bool fromString(const String &address) { return fromString(address.c_str()); }
+
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+        return String(buf);
+    }
+};
+
+inline size_t operator<<(Print &out, const IPAddress &ip) { return out.print(ip.toString()); }
+
+#endif // HOST_IPADDRESS_H
@@ -0,0 +1,21 @@
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "FS.h"
+
+/**
+ * @brief Host stand-in for LittleFS on the spiffs partition (in memory)
+ */
+class LittleFSFS : public fs::FS {
+public:
+    bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+               const char *partitionLabel = "spiffs") {
+        (void)formatOnFail; (void)basePath; (void)maxOpenFiles; (void)partitionLabel;
+        return true;
+    }
+    void end() {}
+};
+
+extern LittleFSFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
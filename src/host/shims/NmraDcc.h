@@ -0,0 +1,87 @@
+#ifndef HOST_NMRADCC_H
+#define HOST_NMRADCC_H
+
+#include <Arduino.h>
+
+#define MAX_DCC_MESSAGE_LEN 6
+
+typedef struct {
+    uint8_t Size;
+    uint8_t PreambleBits;
+    uint8_t Data[MAX_DCC_MESSAGE_LEN];
+} DCC_MSG;
+
+#define CV_ACCESSORY_DECODER_ADDRESS_LSB 1
+#define CV_ACCESSORY_DECODER_ADDRESS_MSB 9
+#define MAN_ID_DIY 0x0D
+#define CV29_OUTPUT_ADDRESS_MODE 0x40
+#define CV29_ACCESSORY_DECODER 0x80
+
+// Callbacks the decoder makes (dcc_handler.cpp)
+void notifyDccMsg(DCC_MSG *Msg);
+void notifyDccAccTurnoutBoard(uint16_t BoardAddr, uint8_t OutputPair, uint8_t Direction, uint8_t OutputPower);
+void notifyDccAccTurnoutOutput(uint16_t Addr, uint8_t Direction, uint8_t OutputPower);
+void notifyDccSigOutputState(uint16_t Addr, uint8_t State);
+
+/**
+ * @brief Host stand-in for the NmraDcc decoder
+ * 
+ * There is no track signal on the host: the harness either calls the
+ * notifyDcc* callbacks directly, or hands raw packets to feed(), which
+ * decodes them the way NmraDcc does for an accessory decoder in output
+ * addressing mode.
+ * CVs are kept in a small table so setCV/getCV round-trip.
+ */
+class NmraDcc {
+private:
+    uint8_t cvs[1024] = {};
+
+public:
+    void pin(uint8_t extIntNum, uint8_t extIntPinNum, uint8_t enablePullup) {
+        (void)extIntNum; (void)extIntPinNum; (void)enablePullup;
+    }
+    void init(uint8_t manufacturerId, uint8_t versionId, uint8_t flags, uint8_t opsModeAddressBaseCV) {
+        (void)manufacturerId; (void)versionId; (void)flags; (void)opsModeAddressBaseCV;
+    }
+    uint8_t process() { return 0; }
+    uint8_t isSetCVReady() { return 1; }
+    uint8_t setCV(uint16_t cv, uint8_t value) { if (cv < sizeof(cvs)) cvs[cv] = value; return value; }
+    uint8_t getCV(uint16_t cv) { return cv < sizeof(cvs) ? cvs[cv] : 0; }
+
+    /**
+     * @brief Decode a packet: notifyDccMsg(), then for a basic accessory
+     * packet notifyDccAccTurnoutBoard() and notifyDccAccTurnoutOutput(),
+     * for an extended accessory packet notifyDccSigOutputState()
+     * @return false if the packet was dropped (bad error detection byte)
+     */
+    bool feed(const uint8_t *data, uint8_t size) {
+        uint8_t check = 0;
+        for (uint8_t i = 0; i < size; i++) check ^= data[i];
+        if (size < 3 || size > MAX_DCC_MESSAGE_LEN || check != 0) return false;
+
+        DCC_MSG msg = {};
+        msg.Size = size;
+        memcpy(msg.Data, data, size);
+        notifyDccMsg(&msg);
+
+        // Basic accessory: 10AAAAAA 1AAACDDD, the high address bits inverted
+        if (size == 3 && (data[0] & 0xC0) == 0x80 && (data[1] & 0x80)) {
+            uint16_t board = ((~data[1] & 0x70) << 2) | (data[0] & 0x3F);
+            uint8_t pair = (data[1] & 0x06) >> 1;
+            uint8_t direction = data[1] & 0x01;
+            uint8_t power = (data[1] & 0x08) >> 3;
+            notifyDccAccTurnoutBoard(board, pair, direction, power);
+            notifyDccAccTurnoutOutput((((board - 1) << 2) | pair) + 1, direction, power);
+        }
+
+        // Extended accessory: 10AAAAAA 0AAA0AA1 000XXXXX, same address bits
+        if (size == 4 && (data[0] & 0xC0) == 0x80 && (data[1] & 0x89) == 0x01) {
+            uint16_t board = ((~data[1] & 0x70) << 2) | (data[0] & 0x3F);
+            uint8_t pair = (data[1] & 0x06) >> 1;
+            notifyDccSigOutputState((((board - 1) << 2) | pair) + 1, data[2] & 0x1F);
+        }
+        return true;
+    }
+};
+
+#endif // HOST_NMRADCC_H
@@ -0,0 +1,87 @@
+#ifndef HOST_WEBSERVER_H
+#define HOST_WEBSERVER_H
+
+#include "WiFi.h"
+#include <functional>
+
+typedef enum { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS } HTTPMethod;
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
+
+/**
+ * @brief Response sink standing in for the web server
+ *
+ * wifi_controller.cpp (routes and form handling) is not part of the host
+ * build, but the page renderers in web_pages.cpp and web_assets.cpp are: this
+ * records what they send (status, bytes, chunks) without keeping it, unless
+ * capture is turned on, so the heap figures are those of the renderer alone.
+ * An If-None-Match request header can be set to try revalidation.
+ */
+class WebServer {
+private:
+    int lastCode = 0;
+    bool chunked = false;
+    size_t bytesSent = 0;
+    uint32_t chunkCount = 0;
+    bool capturing = false;
+    std::string captured;
+    String ifNoneMatch;
+
+    void record(const char *content, size_t length) {
+        bytesSent += length;
+        if (capturing) captured.append(content, length);
+    }
+
+public:
+    typedef std::function<void(void)> THandlerFunction;
+    explicit WebServer(int port = 80) { (void)port; }
+    void on(const String &uri, THandlerFunction handler) { (void)uri; (void)handler; }
+    void on(const String &uri, HTTPMethod method, THandlerFunction handler) { (void)uri; (void)method; (void)handler; }
+    void onNotFound(THandlerFunction handler) { (void)handler; }
+    void begin() {}
+    void handleClient() {}
+
+    void collectHeaders(const char *headerKeys[], const size_t headerKeysCount) { (void)headerKeys; (void)headerKeysCount; }
+    bool hasHeader(const String &name) { return name == "If-None-Match" && ifNoneMatch.length() > 0; }
+    String header(const String &name) { return name == "If-None-Match" ? ifNoneMatch : String(); }
+
+    void setContentLength(size_t length) { chunked = (length == CONTENT_LENGTH_UNKNOWN); }
+    void sendHeader(const String &name, const String &value, bool first = false) { (void)name; (void)value; (void)first; }
+
+    void send(int code, const char *contentType, const String &content) {
+        (void)contentType;
+        lastCode = code;
+        record(content.c_str(), content.length());
+    }
+    void send(int code, const char *contentType, const char *content) { send(code, contentType, String(content)); }
+    void send(int code) { lastCode = code; }
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t length) {
+        (void)contentType;
+        lastCode = code;
+        record(content, length);
+    }
+
+    void sendContent(const char *content, size_t length) {
+        if (!chunked) { record(content, length); return; }
+        if (length == 0) { chunked = false; return; }  // Terminating chunk
+        chunkCount++;
+        record(content, length);
+    }
+    void sendContent(const String &content) { sendContent(content.c_str(), content.length()); }
+    void sendContent_P(PGM_P content, size_t length) { sendContent(content, length); }
+
+    // Harness side
+    void resetResponse(bool capture = false, const char *etag = "") {
+        lastCode = 0; chunked = false; bytesSent = 0; chunkCount = 0;
+        capturing = capture;
+        captured.clear();
+        ifNoneMatch = etag;
+    }
+    int getLastCode() const { return lastCode; }
+    size_t getBytesSent() const { return bytesSent; }
+    uint32_t getChunkCount() const { return chunkCount; }
+    bool isChunkOpen() const { return chunked; }
+    const std::string &getCaptured() const { return captured; }
+};
+
+#endif // HOST_WEBSERVER_H
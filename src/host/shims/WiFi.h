@@ -0,0 +1,73 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+#include "IPAddress.h"
+#include "esp_wifi.h"
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+typedef wifi_mode_t WiFiMode_t;
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+/**
+ * @brief Radio-less WiFi: stays disconnected, remembers the requested mode
+ */
+class WiFiClass {
+private:
+    wifi_mode_t currentMode = WIFI_OFF;
+
+public:
+    bool mode(wifi_mode_t m) { currentMode = m; return true; }
+    wifi_mode_t getMode() { return currentMode; }
+    wl_status_t begin(const char *ssid, const char *passphrase = nullptr) { (void)ssid; (void)passphrase; return WL_DISCONNECTED; }
+    bool config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress()) {
+        (void)local; (void)gateway; (void)subnet; (void)dns1; (void)dns2;
+        return true;
+    }
+    bool disconnect(bool wifioff = false, bool eraseap = false) { (void)eraseap; if (wifioff) currentMode = WIFI_OFF; return true; }
+    wl_status_t status() { return WL_DISCONNECTED; }
+    bool isConnected() { return false; }
+    bool setHostname(const char *hostname) { (void)hostname; return true; }
+
+    String SSID() { return String(); }
+    String SSID(uint8_t networkItem) { (void)networkItem; return String(); }
+    int32_t RSSI() { return 0; }
+    int32_t RSSI(uint8_t networkItem) { (void)networkItem; return 0; }
+    int32_t channel() { return 0; }
+    int32_t channel(uint8_t networkItem) { (void)networkItem; return 0; }
+    wifi_auth_mode_t encryptionType(uint8_t networkItem) { (void)networkItem; return WIFI_AUTH_OPEN; }
+    int16_t scanNetworks(bool async = false, bool showHidden = false) { (void)async; (void)showHidden; return 0; }
+    void scanDelete() {}
+
+    IPAddress localIP() { return IPAddress(); }
+    IPAddress gatewayIP() { return IPAddress(); }
+    IPAddress subnetMask() { return IPAddress(); }
+    IPAddress dnsIP(uint8_t dnsNo = 0) { (void)dnsNo; return IPAddress(); }
+    String macAddress() { return String("24:0A:C4:12:34:56"); }
+    uint8_t *macAddress(uint8_t *mac) {
+        static const uint8_t hostMac[6] = {0x24, 0x0A, 0xC4, 0x12, 0x34, 0x56};
+        memcpy(mac, hostMac, sizeof(hostMac));
+        return mac;
+    }
+
+    bool softAP(const char *ssid, const char *passphrase = nullptr, int channel = 1, int ssidHidden = 0, int maxConnection = 4) {
+        (void)ssid; (void)passphrase; (void)channel; (void)ssidHidden; (void)maxConnection;
+        return true;
+    }
+    bool softAPConfig(IPAddress local, IPAddress gateway, IPAddress subnet) { (void)local; (void)gateway; (void)subnet; return true; }
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+    uint8_t softAPgetStationNum() { return 0; }
+};
+
+extern WiFiClass WiFi;
+
+#endif // HOST_WIFI_H
@@ -0,0 +1,6 @@
+#ifndef HOST_WIFIAP_H
+#define HOST_WIFIAP_H
+
+#include "WiFi.h"
+
+#endif // HOST_WIFIAP_H
@@ -0,0 +1,19 @@
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+/*
+ * Tasks are registered but never scheduled: the host harness is single
+ * threaded and calls the work function itself (e.g. servoTask.tick()).
+ */
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name, uint32_t stackDepth, void *param,
+                                   UBaseType_t priority, TaskHandle_t *createdTask, BaseType_t coreId);
+TickType_t xTaskGetTickCount();
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t *previousWakeTime, TickType_t timeIncrement);
+
+#endif // HOST_FREERTOS_TASK_H
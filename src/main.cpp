@@ -6,6 +6,10 @@
 #include "wifi_controller.h"
 #include "core/system_manager.h"
 #include "utils/dcc_debug_logger.h"
+#include "utils/eeprom_writer.h"
+#include "utils/servo_state_log.h"
+#include "utils/diag_log.h"
+#include "utils/dcc_capture.h"
 #include <WiFi.h>
 
 // Auxiliary variables to store the current output state
@@ -17,11 +21,6 @@ void triggerDccSignal() {
     systemManager.triggerDccSignal();
 }
 
-// Function to add message to DCC debug log (for backward compatibility)
-void addDccLogMessage(const String& message) {
-    dccDebugLogger.addMessage(message);
-}
-
 // Function to enable/disable DCC debug (for backward compatibility)
 void toggleDccDebug() {
     systemManager.toggleDccDebug();
@@ -31,6 +30,9 @@ void setup() {
     // Initialize serial communication
     initializeSerial();
     
+    // Diagnostic messages are queued and written out by their own task
+    diagLog.begin();
+    
     // Initialize EEPROM
     initializeEEPROM();
     
@@ -42,12 +44,12 @@ void setup() {
     
     Serial.println("Boot complete\n");
 
-    // Initialize system manager (handles LED, factory reset, etc.)
-    systemManager.begin();
-
-    // Initialize servo system
+    // Initialize servo system (PWM timers must exist before the servo task runs)
     initializeServos();
 
+    // Initialize system manager (handles LED, factory reset, servo task, etc.)
+    systemManager.begin();
+
     // Initialize DCC system
     initializeDCC();
     
@@ -68,4 +70,16 @@ void loop() {
     
     // Handle WiFi events
     handleWiFiEvents();
+    
+    // Commit saved settings once they stop changing
+    eepromWriter.update();
+    
+    // Save turnout positions once they stop changing
+    servoStateLog.update(getSettledThrownMask());
+    
+    // Move captured DCC packets to flash a batch at a time (capture file)
+    dccCapture.update();
+    
+    // Echo new DCC debug records (debug mode)
+    dccDebugLogger.update();
 }
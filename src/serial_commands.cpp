@@ -5,6 +5,18 @@
 #include "config.h"
 #include "version.h"
 #include "utils/dcc_debug_logger.h"
+#include "utils/dcc_address_index.h"
+#include "utils/servo_easing.h"
+#include "utils/eeprom_writer.h"
+#include "utils/config_journal.h"
+#include "utils/servo_state_log.h"
+#include "utils/diag_log.h"
+#include "utils/dcc_capture.h"
+#include "utils/dcc_repeat_filter.h"
+#include "hardware/servo_output.h"
+#include "core/servo_command_queue.h"
+#include "core/servo_task.h"
+#include "core/servo_move_scheduler.h"
 #include <esp_wifi.h>
 #include <ESPmDNS.h>
 
@@ -74,7 +86,11 @@ void processSerialCommands() {
     
     newData = false;
     
-    switch (receivedChars[0]) {
+    // Word commands ("stats", "wifi", "history") start with the letter of a
+    // one-letter command, so anything with a second letter is looked up as a word
+    char commandLetter = isalpha(receivedChars[1]) ? '\0' : receivedChars[0];
+    
+    switch (commandLetter) {
         case 's':
             processServoConfigCommand();
             break;
@@ -117,8 +133,10 @@ void processSerialCommands() {
         case 'h':
         case '?':
             Serial.println("Commands:");
-            Serial.println("s servo,addr,swing,offset,speed,invert,continuous - Configure servo");
-            Serial.println("p servo,command - Manual control (c=closed, t=thrown, T=toggle, n=neutral)");
+            Serial.println("s servo,addr,swing,offset,speed,invert,continuous[,easing] - Configure servo");
+            Serial.println("sm [output[,shift] | board,base[,shift]] - Show/set DCC addressing (per servo, or a block of boards)");
+            Serial.println("sa [servo[,p0,p1,...,p7]] - Show/set signal aspect positions (% of travel closed->thrown, - = unused)");
+            Serial.println("p servo,command - Manual control (c=closed, t=thrown, T=toggle, n=neutral, a0-a7=aspect, ! = priority)");
             Serial.println("d address,command - DCC emulation");
             Serial.println("x - Display all servo configurations");
             Serial.println("v - Show version and feature information");
@@ -132,11 +150,17 @@ void processSerialCommands() {
             Serial.println("history - Show version history and changelog");
             Serial.println("mdns - Test mDNS functionality and restart if needed");
             Serial.println("hostname [name] - Show/set device hostname for mDNS");
+            Serial.println("stats [reset] - Show servo task timing statistics");
+            Serial.println("save - Write pending settings to EEPROM now (otherwise after 2s without changes)");
+            Serial.println("log [none|error|warn|info|debug] - Show/set diagnostic output level");
+            Serial.println("capture [ram|file|off] - Record raw DCC packets for replay (download /dcc-capture)");
             Serial.println();
             Serial.println("Servo numbers: 0-15 (maps to GPIO pins automatically)");
             Serial.println("GPIO pins can also be used directly");
-            Serial.println("Speed: 0=Instant, 1=Fast, 2=Normal, 3=Slow");
+            Serial.println("Speed: 0=Instant, 1=Fast, 2=Normal, 3=Slow, or 4-1000 degrees/second");
+            Serial.println("Easing: 0=Linear, 1=EaseInOut, 2=S-Curve, 3=Bounce (optional, kept if omitted)");
             Serial.println("Offset: Maximum ±50% of swing angle (e.g., swing=40° allows ±20° offset)");
+            Serial.println("Shift: 0=RCN-213 numbering, 4=station numbers board 0 as addresses 1-4 (e.g. Roco)");
             break;
         case 'r':
             Serial.println("Virtual routes not yet implemented");
@@ -161,6 +185,18 @@ void processSerialCommands() {
                 processMDNSTestCommand();
             } else if (command.startsWith("hostname ")) {
                 processHostnameCommand();
+            } else if (command.startsWith("stats")) {
+                processStatsCommand();
+            } else if (command.startsWith("save")) {
+                processSaveCommand();
+            } else if (command.startsWith("log")) {
+                processLogLevelCommand();
+            } else if (command.startsWith("capture")) {
+                processCaptureCommand();
+            } else if (command.startsWith("sm")) {
+                processAddressingCommand();
+            } else if (command == "sa" || command.startsWith("sa ")) {
+                processAspectCommand();
             } else {
                 Serial.println("Unknown command. Type 'h' for help.");
             }
@@ -169,8 +205,9 @@ void processSerialCommands() {
 }
 
 void processServoConfigCommand() {
-    // Command format: s servo,addr,swing,offset,speed,invert,continuous
+    // Command format: s servo,addr,swing,offset,speed,invert,continuous[,easing]
     VIRTUALSERVO vsParse;
+    vsParse.easing = EASING_COUNT;  // Not given - keep the servo's current profile
     char *pch;
     int i = 0;
     pch = strtok(receivedChars, " ,");
@@ -214,10 +251,9 @@ void processServoConfigCommand() {
                 }
                 break;
             case 5:
-                vsParse.speed = atoi(pch);
-                if (vsParse.speed > SPEED_SLOW) {
+                if (!parseServoSpeed(atol(pch), vsParse.speed)) {
                     i = 10;
-                    Serial.println("Error: Invalid speed (0=Instant, 1=Fast, 2=Normal, 3=Slow)");
+                    Serial.printf("Error: Invalid speed (0=Instant, 1=Fast, 2=Normal, 3=Slow, or 4-%d degrees/second)\n", SERVO_MAX_SPEED_DPS);
                 }
                 break;
             case 6:
@@ -226,42 +262,60 @@ void processServoConfigCommand() {
             case 7:
                 vsParse.continuous = atoi(pch) == 0 ? false : true;
                 break;
+            case 8:
+                vsParse.easing = atoi(pch);
+                if (vsParse.easing >= EASING_COUNT) {
+                    i = 10;
+                    Serial.println("Error: Invalid easing (0=Linear, 1=EaseInOut, 2=S-Curve, 3=Bounce)");
+                }
+                break;
         }
         ++i;
         pch = strtok(NULL, " ,");
     }
 
-    if (i != 8) {
+    if ((i != 8) && (i != 9)) {
         Serial.println("Error: Invalid command format");
-        Serial.println("Usage: s servo,addr,swing,offset,speed,invert,continuous");
+        Serial.println("Usage: s servo,addr,swing,offset,speed,invert,continuous[,easing]");
         Serial.println("Note: Offset cannot exceed 50% of swing value (e.g., swing=40° allows offset ±20°)");
-        Serial.println("Parameters: servo(0-15), addr(1-2048), swing(1-90°), offset(±degrees), speed(0-3), invert(0/1), continuous(0/1)");
-        Serial.println("Speed: 0=Instant, 1=Fast, 2=Normal, 3=Slow");
+        Serial.println("Parameters: servo(0-15), addr(1-2048), swing(1-90°), offset(±degrees), speed(0-3 or °/s), invert(0/1), continuous(0/1)");
+        Serial.printf("Speed: 0=Instant, 1=Fast (%d°/s), 2=Normal (%d°/s), 3=Slow (%d°/s), 4-%d=degrees/second\n",
+                      SERVO_SPEED_FAST_DPS, SERVO_SPEED_NORMAL_DPS, SERVO_SPEED_SLOW_DPS, SERVO_MAX_SPEED_DPS);
         Serial.println("Example: s 0,100,25,0,2,0,0  (servo 0, normal speed)");
         Serial.println("Example: s 5,101,30,5,1,0,0  (GPIO 5, fast speed)");
+        Serial.println("Example: s 2,102,30,0,90,0,0,2  (servo 2, 90°/s, S-curve easing)");
     } else {
         Serial.println("OK - Servo configured");
         
         // Match to a pin member of servo slot and copy it over
         for (auto &vs : virtualservo) {
             if (vs.pin == vsParse.pin) {
-                // First copy servo-driver pointer to vsParse
-                vsParse.thisDriver = vs.thisDriver;
-                // Then copy vsParse to virtualservo[]
-                vs = vsParse;
-                
-                // Set servo to closed position when configuration changes
-                uint8_t centerPosition = 90 + vs.offset;  // Apply offset to center position
-                if (vs.invert) {
-                    vs.position = centerPosition + vs.swing;  // Max position for inverted
-                } else {
-                    vs.position = centerPosition - vs.swing;  // Min position for normal
-                }
-                vs.state = SERVO_TO_CLOSED;
-                
-                // Immediately attach servo and start movement to closed position
-                if (!vs.thisDriver->attached()) {
-                    vs.thisDriver->attach(vs.pin);
+                {
+                    // Hold off the servo tick while the slot is rewritten
+                    ServoConfigLock lock;
+                    
+                    // First copy servo-driver pointer, aspect table (and easing, if not given) to vsParse
+                    vsParse.thisDriver = vs.thisDriver;
+                    memcpy(vsParse.aspects, vs.aspects, sizeof(vsParse.aspects));
+                    if (vsParse.easing >= EASING_COUNT) vsParse.easing = vs.easing;
+                    // Then copy vsParse to virtualservo[]
+                    vs = vsParse;
+                    refreshServoConfig();
+                    
+                    // Set servo to closed position when configuration changes
+                    uint8_t centerPosition = 90 + vs.offset;  // Apply offset to center position
+                    if (vs.invert) {
+                        setServoPosition(vs, centerPosition + vs.swing);  // Max position for inverted
+                    } else {
+                        setServoPosition(vs, centerPosition - vs.swing);  // Min position for normal
+                    }
+                    vs.state = SERVO_TO_CLOSED;
+                    
+                    // Attach servo and start movement to closed position on the next tick
+                    uint8_t channel = &vs - virtualservo;
+                    if (!servoOutput.attached(channel)) {
+                        servoOutput.attach(channel, vs.pin);
+                    }
                 }
                 
                 Serial.print("Servo ");
@@ -269,6 +323,10 @@ void processServoConfigCommand() {
                 Serial.print(" moving to closed position (");
                 Serial.print(vs.position);
                 Serial.println("°)");
+                if (dccAddressIndex.isBoardMode()) {
+                    Serial.printf("Note: board addressing in use, servo answers to address %u ('sm output' to use %u)\n",
+                                  dccAddressIndex.getServoAddress(&vs - virtualservo), vs.address);
+                }
                 
                 // Write to EEPROM
                 bootController.isDirty = true;
@@ -279,13 +337,148 @@ void processServoConfigCommand() {
     }
 }
 
+static void printAddressing() {
+    const DccAddressing &addressing = dccAddressIndex.getAddressing();
+    if (addressing.mode == DCC_ADDRESS_MODE_BOARD) {
+        uint16_t first = dccAddressIndex.getBlockFirstAddress();
+        Serial.printf("DCC addressing: boards %u-%u (addresses %u-%u, servo n on address %u+n), shift %s\n",
+                      addressing.boardBase, addressing.boardBase + DCC_BLOCK_BOARDS - 1, first,
+                      first + TOTAL_PINS - 1, first, DccAddressIndex::getShiftName(addressing.shift));
+    } else {
+        Serial.printf("DCC addressing: output address per servo (set with 's'), shift %s\n",
+                      DccAddressIndex::getShiftName(addressing.shift));
+    }
+}
+
+void processAddressingCommand() {
+    // Command format: sm [output[,shift] | board,base[,shift]]
+    DccAddressing settings = dccAddressIndex.getAddressing();
+    char *pch = strtok(receivedChars, " ,");  // "sm"
+    pch = strtok(NULL, " ,");
+    
+    if (pch != NULL) {
+        bool valid = true;
+        if (strcmp(pch, "output") == 0) {
+            settings.mode = DCC_ADDRESS_MODE_OUTPUT;
+        } else if (strcmp(pch, "board") == 0) {
+            settings.mode = DCC_ADDRESS_MODE_BOARD;
+            pch = strtok(NULL, " ,");
+            if (pch != NULL) {
+                settings.boardBase = atoi(pch);
+            } else {
+                valid = false;
+            }
+        } else {
+            valid = false;
+        }
+        
+        pch = strtok(NULL, " ,");
+        if (valid && pch != NULL) {
+            settings.shift = atoi(pch);
+        }
+        
+        if (!valid || !DccAddressIndex::isValid(settings)) {
+            Serial.println("Error: Invalid addressing");
+            Serial.println("Usage: sm output[,shift]  or  sm board,base[,shift]");
+            Serial.printf("base: first board address, 1-%d (the block is %d boards, %d outputs)\n",
+                          DCC_MAX_BOARD_BASE, DCC_BLOCK_BOARDS, TOTAL_PINS);
+            Serial.println("shift: 0=RCN-213 numbering, 4=station numbers board 0 as addresses 1-4 (e.g. Roco)");
+            Serial.println("Example: sm board,26  (servos 0-15 on addresses 101-116)");
+            return;
+        }
+        
+        {
+            ServoConfigLock lock;
+            dccAddressIndex.configure(settings);
+            refreshServoConfig();
+        }
+        bootController.isDirty = true;
+        putSettings();
+        Serial.println("OK - DCC addressing set");
+    }
+    
+    printAddressing();
+}
+
+static void printAspects(uint8_t servo) {
+    char table[SERVO_ASPECT_COUNT * 4 + 1];
+    formatServoAspects(virtualservo[servo].aspects, table, sizeof(table));
+    Serial.printf("Servo %u aspects: %s\n", servo, table[0] ? table : "none");
+}
+
+void processAspectCommand() {
+    // Command format: sa [servo[,p0,p1,...]]
+    char *text = receivedChars + 2;
+    while (*text == ' ') text++;
+    
+    if (*text == '\0') {
+        for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+            printAspects(i);
+        }
+        return;
+    }
+    
+    char *table = strchr(text, ',');
+    if (table != NULL) *table++ = '\0';
+    
+    uint8_t servo = getServoNumberFromGpioPin(validateAndConvertPin(atoi(text)));
+    if (servo >= TOTAL_PINS) {
+        Serial.println("Error: Invalid servo number/pin");
+        return;
+    }
+    
+    if (table != NULL) {
+        uint8_t aspects[SERVO_ASPECT_COUNT];
+        if (!parseServoAspects(table, aspects)) {
+            Serial.println("Error: Invalid aspect table");
+            Serial.printf("Usage: sa servo,p0,p1,...  (up to %u positions, 0=closed to 100=thrown, - = unused)\n",
+                          SERVO_ASPECT_COUNT);
+            Serial.println("Example: sa 3,0,50,100  (3-position arm: aspect 0 closed, 1 half way, 2 thrown)");
+            return;
+        }
+        
+        {
+            ServoConfigLock lock;
+            memcpy(virtualservo[servo].aspects, aspects, sizeof(aspects));
+            refreshServoConfig();
+        }
+        bootController.isDirty = true;
+        putSettings();
+        Serial.println("OK - Aspects set");
+    }
+    
+    printAspects(servo);
+}
+
+// Map a p/d command to a queued servo target. A trailing '!' marks the
+// command as priority, so the servo jumps the move queue (e.g. "t!").
+static bool parseServoCommandTarget(const char *text, uint8_t &target) {
+    const char *suffix = text + 1;
+    switch (text[0]) {
+        case 'c': target = SERVO_CMD_CLOSE; break;
+        case 't': target = SERVO_CMD_THROW; break;
+        case 'n': target = SERVO_CMD_NEUTRAL; break;
+        case 'T': target = SERVO_CMD_TOGGLE; break;
+        case 'a':
+            // Signal aspect, a0-a7
+            if ((text[1] < '0') || (text[1] >= '0' + SERVO_ASPECT_COUNT)) return false;
+            target = SERVO_CMD_ASPECT + (text[1] - '0');
+            suffix++;
+            break;
+        default: return false;
+    }
+    if (*suffix == '!') target |= SERVO_CMD_PRIORITY;
+    return true;
+}
+
 void processServoControlCommand() {
     // Command format: p pin,command
     char *pch;
     int i = 0;
     pch = strtok(receivedChars, " ,");
     int p = -1;
-    VIRTUALSERVO *targetVirtualServo = nullptr;
+    int8_t servoNum = -1;
+    bool queueFull = false;
 
     while (pch != NULL) {
         switch (i) {
@@ -302,35 +495,20 @@ void processServoControlCommand() {
                         break;
                     }
                     // p is valid, use this to lookup the servo slot
-                    for (auto &vs : virtualservo) {
-                        if (vs.pin != p) continue;
-                        targetVirtualServo = &vs;
-                    }
+                    servoNum = getServoNumberFromGpioPin(p);
                 }
                 break;
 
             case 2:
-                if (targetVirtualServo == nullptr) { 
+                if (servoNum < 0) { 
                     i = 10;
                     break; 
                 }
-                switch (pch[0]) {
-                    case 'c':
-                        targetVirtualServo->state = SERVO_TO_CLOSED;
-                        break;
-                    case 't':
-                        targetVirtualServo->state = SERVO_TO_THROWN;
-                        break;
-                    case 'n':
-                        targetVirtualServo->state = SERVO_NEUTRAL;
-                        break;
-                    case 'T':
-                        if (targetVirtualServo->state == SERVO_CLOSED) {
-                            targetVirtualServo->state = SERVO_TO_THROWN;
-                        } else {
-                            targetVirtualServo->state = SERVO_TO_CLOSED;
-                        }
-                        break;
+                {
+                    uint8_t target;
+                    if (parseServoCommandTarget(pch, target)) {
+                        queueFull = !servoCommandQueue.push(1U << servoNum, target, SERVO_SRC_SERIAL);
+                    }
                 }
                 break;
         }
@@ -339,11 +517,15 @@ void processServoControlCommand() {
     }
 
     if (i == 3) {
-        Serial.println("OK - Servo command executed");
+        if (queueFull) {
+            Serial.println("Error: Servo command queue full, command dropped");
+        } else {
+            Serial.println("OK - Servo command executed");
+        }
     } else {
         Serial.println("Error: Invalid command format");
         Serial.println("Usage: p servo,command");
-        Serial.println("Commands: c=closed, t=thrown, T=toggle, n=neutral");
+        Serial.println("Commands: c=closed, t=thrown, T=toggle, n=neutral, a0-a7=aspect (add ! to jump the move queue, e.g. t!)");
         Serial.println("Example: p 0,t  (servo 0, thrown)");
         Serial.println("Example: p 12,c (GPIO 12, closed)");
     }
@@ -355,6 +537,7 @@ void processDccEmulationCommand() {
     int i = 0;
     pch = strtok(receivedChars, " ,");
     int a = -1;
+    bool queueFull = false;
     
     while (pch != NULL) {
         switch (i) {
@@ -369,27 +552,15 @@ void processDccEmulationCommand() {
                 break;
 
             case 2:
-                // Command
-                for (auto &vs : virtualservo) {
-                    if (vs.address != a) continue;
-
-                    switch (pch[0]) {
-                        case 't':
-                            vs.state = SERVO_TO_THROWN;
-                            break;
-                        case 'n':
-                            vs.state = SERVO_NEUTRAL;
-                            break;
-                        case 'T':
-                            if (vs.state == SERVO_CLOSED) {
-                                vs.state = SERVO_TO_THROWN;
-                            } else {
-                                vs.state = SERVO_TO_CLOSED;
-                            }
-                            break;
-                        default:
-                            vs.state = SERVO_TO_CLOSED;
-                            break;
+                // Command - anything unrecognised closes, as a DCC packet would
+                {
+                    uint8_t target;
+                    if (!parseServoCommandTarget(pch, target)) {
+                        target = SERVO_CMD_CLOSE;
+                    }
+                    uint16_t servoMask = dccAddressIndex.lookup(a);
+                    if (servoMask != 0) {
+                        queueFull = !servoCommandQueue.push(servoMask, target, SERVO_SRC_DCC_EMULATION);
                     }
                 }
                 break;
@@ -399,21 +570,23 @@ void processDccEmulationCommand() {
     }
 
     if (i == 3) {
-        Serial.println("OK - DCC command emulated");
+        if (queueFull) {
+            Serial.println("Error: Servo command queue full, command dropped");
+        } else {
+            Serial.println("OK - DCC command emulated");
+        }
     } else {
         Serial.println("Error: Invalid command format");
         Serial.println("Usage: d address,command");
-        Serial.println("Commands: c=closed, t=thrown, T=toggle, n=neutral");
+        Serial.println("Commands: c=closed, t=thrown, T=toggle, n=neutral, a0-a7=aspect (add ! to jump the move queue)");
         Serial.println("Example: d 100,c");
     }
 }
 
 void processDisplayCommand() {
     Serial.println("Servo Configuration:");
-    Serial.println("Servo\tGPIO\tAddr\tSwing\tOffset\tSpeed\tInvert\tCont\tStatus");
-    Serial.println("-----\t----\t----\t-----\t------\t-----\t------\t----\t------");
-    
-    const char* speedNames[] = {"Instant", "Fast", "Normal", "Slow"};
+    Serial.println("Servo\tGPIO\tAddr\tSwing\tOffset\tSpeed\tEasing\tInvert\tCont\tStatus");
+    Serial.println("-----\t----\t----\t-----\t------\t-----\t------\t------\t----\t------");
     
     for (uint8_t i = 0; i < TOTAL_PINS; i++) {
         auto vs = virtualservo[i];
@@ -423,13 +596,20 @@ void processDisplayCommand() {
         Serial.print("\t");
         Serial.print(vs.pin, DEC);
         Serial.print("\t");
-        Serial.print(vs.address, DEC);
+        Serial.print(dccAddressIndex.getServoAddress(i), DEC);
         Serial.print("\t");
         Serial.print(vs.swing, DEC);
         Serial.print("\t");
         Serial.print(vs.offset, DEC);
         Serial.print("\t");
-        Serial.print(speedNames[vs.speed]);
+        const char* speedName = getServoSpeedName(vs.speed);
+        if (speedName != nullptr) {
+            Serial.print(speedName);
+        } else {
+            Serial.printf("%u°/s", vs.speed);
+        }
+        Serial.print("\t");
+        Serial.print(getServoEasingName(vs.easing));
         Serial.print("\t");
         Serial.print(vs.invert, DEC);
         Serial.print("\t");
@@ -442,6 +622,23 @@ void processDisplayCommand() {
             Serial.println("OK");
         }
     }
+    
+    Serial.printf("\nServo moves: %u moving, %u queued (max %u at once; peak %u moving, %u queued), %lu deferred, %lu priority\n",
+                  servoMoveScheduler.getMovingCount(), servoMoveScheduler.getWaitingCount(),
+                  servoMoveScheduler.getMaxConcurrent(), servoMoveScheduler.getPeakMoving(),
+                  servoMoveScheduler.getPeakWaiting(),
+                  (unsigned long)servoMoveScheduler.getDeferredCount(),
+                  (unsigned long)servoMoveScheduler.getPriorityCount());
+    Serial.printf("Servo output: %lu writes issued, %lu suppressed (unchanged), %lu attaches, %lu detaches\n",
+                  (unsigned long)servoOutput.getIssuedWrites(),
+                  (unsigned long)servoOutput.getSuppressedWrites(),
+                  (unsigned long)servoOutput.getAttachCount(),
+                  (unsigned long)servoOutput.getDetachCount());
+    Serial.printf("Command queue: %u queued (peak %u), %lu total, %lu dropped, %lu coalesced\n",
+                  servoCommandQueue.getDepth(), servoCommandQueue.getPeakDepth(),
+                  (unsigned long)servoCommandQueue.getPushedCount(),
+                  (unsigned long)servoCommandQueue.getDroppedCount(),
+                  (unsigned long)servoCommandQueue.getCoalescedCount());
 }
 
 void processAPConfigCommand() {
@@ -909,9 +1106,9 @@ void processDccDebugCommand() {
     Serial.println("\nConfigured DCC addresses:");
     bool hasAddresses = false;
     for (int i = 0; i < TOTAL_PINS; i++) {
-        if (virtualservo[i].address != 0) {
+        if (dccAddressIndex.getServoAddress(i) != 0) {
             Serial.printf("  Servo %d (GPIO %d): Address %d\n", 
-                         i, virtualservo[i].pin, virtualservo[i].address);
+                         i, virtualservo[i].pin, dccAddressIndex.getServoAddress(i));
             hasAddresses = true;
         }
     }
@@ -924,3 +1121,147 @@ void processDccDebugCommand() {
     Serial.println("\nType 'z' again to toggle debug mode.");
     Serial.println("==================");
 }
+
+void processStatsCommand() {
+    // Command format: stats [reset]
+    if (strncmp(receivedChars, "stats reset", 11) == 0) {
+        servoTask.resetStats();
+        servoOutput.resetStats();
+        diagLog.resetStats();
+        Serial.println("Servo timing and output statistics reset");
+        return;
+    }
+    
+    Serial.println("=== Servo Task Timing ===");
+    Serial.printf("Status: %s\n", servoTask.isRunning() ? "Running" : "Stopped");
+    Serial.printf("Target interval: %d ms\n", SERVO_UPDATE_INTERVAL);
+    Serial.printf("Ticks measured: %lu\n", (unsigned long)servoTask.getTickCount());
+    Serial.printf("Tick period: min %lu us, avg %lu us, max %lu us\n",
+                  (unsigned long)servoTask.getMinPeriodUs(),
+                  (unsigned long)servoTask.getAvgPeriodUs(),
+                  (unsigned long)servoTask.getMaxPeriodUs());
+    Serial.printf("Late ticks (>1.5x interval): %lu\n", (unsigned long)servoTask.getLateTicks());
+    Serial.printf("Longest tick run time: %lu us\n", (unsigned long)servoTask.getMaxRunUs());
+    Serial.printf("Idle ticks: %lu, avg %lu cycles, max %lu cycles\n",
+                  (unsigned long)servoTask.getIdleTicks(),
+                  (unsigned long)servoTask.getAvgIdleCycles(),
+                  (unsigned long)servoTask.getMaxIdleCycles());
+    Serial.printf("Active ticks: %lu, avg %lu cycles\n",
+                  (unsigned long)servoTask.getActiveTicks(),
+                  (unsigned long)servoTask.getAvgActiveCycles());
+    Serial.printf("Active servos: 0x%04X\n", getActiveServoMask());
+    const ServoBootReport &boot = getServoBootReport();
+    if (boot.complete) {
+        Serial.printf("Last boot: %u driven, %u already in place, %u restored to thrown, %lu ms (groups of %d)\n",
+                      boot.booted, boot.skipped, boot.thrown, (unsigned long)boot.durationMs, SERVO_BOOT_GROUP_SIZE);
+    } else {
+        Serial.println("Last boot: in progress");
+    }
+    Serial.printf("EEPROM: %lu commits this boot (%lu failed), %lu lifetime, %lu saves (%lu unchanged), %s\n",
+                  (unsigned long)eepromWriter.getCommitCount(),
+                  (unsigned long)eepromWriter.getFailedCount(),
+                  (unsigned long)eepromWriter.getLifetimeCommits(),
+                  (unsigned long)eepromWriter.getPutCount(),
+                  (unsigned long)eepromWriter.getUnchangedCount(),
+                  eepromWriter.isPending() ? "write pending" : "clean");
+    Serial.printf("EEPROM commit time: last %lu us, max %lu us\n",
+                  (unsigned long)eepromWriter.getLastCommitUs(),
+                  (unsigned long)eepromWriter.getMaxCommitUs());
+    if (configJournal.isReady()) {
+        Serial.printf("Journal: sector %u of %u, %lu bytes used, %lu appends, %lu erases this boot, %lu lifetime (max %lu per sector)\n",
+                      configJournal.getLiveSector(), configJournal.getSectorCount(),
+                      (unsigned long)configJournal.getUsedBytes(),
+                      (unsigned long)configJournal.getAppendCount(),
+                      (unsigned long)configJournal.getEraseCount(),
+                      (unsigned long)configJournal.getLifetimeErases(),
+                      (unsigned long)configJournal.getMaxSectorErases());
+    } else {
+        Serial.println("Journal: not in use");
+    }
+    if (servoStateLog.isReady()) {
+        Serial.printf("Servo states: 0x%04X saved, %s, %lu writes, %lu erases, slot %u\n",
+                      servoStateLog.getState(), servoStateLog.isPending() ? "write pending" : "clean",
+                      (unsigned long)servoStateLog.getWriteCount(),
+                      (unsigned long)servoStateLog.getEraseCount(),
+                      servoStateLog.getSlot());
+    } else {
+        Serial.println("Servo states: not kept");
+    }
+    Serial.printf("DCC repeats: %lu commands (%lu reversals), %lu repeats ignored (window %dms)\n",
+                  (unsigned long)dccRepeatFilter.getAcceptedCount(),
+                  (unsigned long)dccRepeatFilter.getReversalCount(),
+                  (unsigned long)dccRepeatFilter.getSuppressedCount(), DCC_REPEAT_WINDOW_MS);
+    Serial.printf("DCC capture: %s, %lu packets (%lu in file), %lu lost, %lu idle skipped\n",
+                  dccCapture.isEnabled() ? (dccCapture.isSpilling() ? "recording to file" : "recording to RAM") : "stopped",
+                  (unsigned long)dccCapture.getRecordCount(),
+                  (unsigned long)dccCapture.getFileCount(),
+                  (unsigned long)dccCapture.getLostCount(),
+                  (unsigned long)dccCapture.getIdleCount());
+    Serial.printf("Diagnostics: level %s, %lu messages, %lu dropped (%lu rate-limited, %lu ring full), %lu/%d bytes queued (peak %lu)\n",
+                  DiagLog::getLevelName(diagLog.getLevel()),
+                  (unsigned long)diagLog.getLoggedCount(),
+                  (unsigned long)diagLog.getDroppedCount(),
+                  (unsigned long)diagLog.getRateDropCount(),
+                  (unsigned long)diagLog.getFullDropCount(),
+                  (unsigned long)diagLog.getQueuedBytes(), DIAG_RING_SIZE,
+                  (unsigned long)diagLog.getPeakQueuedBytes());
+    Serial.println("==================");
+}
+
+void processSaveCommand() {
+    // Command format: save
+    if (!eepromWriter.isPending()) {
+        Serial.println("No unsaved settings");
+        return;
+    }
+    flushSettings();
+}
+
+void processLogLevelCommand() {
+    // Command format: log [none|error|warn|info|debug]
+    char *arg = receivedChars + 3;
+    while (*arg == ' ') arg++;
+    
+    if (*arg != '\0') {
+        uint8_t newLevel;
+        for (newLevel = DIAG_LEVEL_NONE; newLevel <= DIAG_LEVEL_DEBUG; newLevel++) {
+            if (strcmp(arg, DiagLog::getLevelName(newLevel)) == 0) break;
+        }
+        if (newLevel > DIAG_LEVEL_DEBUG) {
+            Serial.println("Error: Level must be none, error, warn, info or debug");
+            return;
+        }
+        diagLog.setLevel(newLevel);
+    }
+    Serial.printf("Diagnostic level: %s (compiled up to %s)\n",
+                  DiagLog::getLevelName(diagLog.getLevel()), DiagLog::getLevelName(DIAG_LEVEL_MAX));
+}
+
+void processCaptureCommand() {
+    // Command format: capture [ram|file|off]
+    char *arg = receivedChars + 7;
+    while (*arg == ' ') arg++;
+    
+    if (strcmp(arg, "ram") == 0 || strcmp(arg, "file") == 0) {
+        bool toFile = (arg[0] == 'f');
+        if (!dccCapture.start(toFile)) {
+            Serial.println("Error: Could not start the capture file");
+            return;
+        }
+        Serial.printf("DCC capture started (%s)\n", toFile ? "spilled to " DCC_CAPTURE_FILE : "most recent packets in RAM");
+    } else if (strcmp(arg, "off") == 0) {
+        dccCapture.stop();
+        Serial.println("DCC capture stopped");
+    } else if (*arg != '\0') {
+        Serial.println("Error: Use capture ram, capture file or capture off");
+        return;
+    }
+    
+    Serial.printf("DCC capture: %s, %lu packets held (%lu in file), %lu lost, %lu idle skipped\n",
+                  dccCapture.isEnabled() ? "recording" : "stopped",
+                  (unsigned long)dccCapture.getRecordCount(),
+                  (unsigned long)dccCapture.getFileCount(),
+                  (unsigned long)dccCapture.getLostCount(),
+                  (unsigned long)dccCapture.getIdleCount());
+    Serial.println("Download from /dcc-capture on the web interface");
+}
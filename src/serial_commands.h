@@ -16,6 +16,8 @@ void initializeSerial();
 void recvWithEndMarker();
 void processSerialCommands();
 void processServoConfigCommand();
+void processAddressingCommand();
+void processAspectCommand();
 void processServoControlCommand();
 void processDccEmulationCommand();
 void processDisplayCommand();
@@ -27,5 +29,9 @@ void processWiFiStatusCommand();
 void processMDNSTestCommand();
 void processHostnameCommand();
 void processDccDebugCommand();
+void processStatsCommand();
+void processSaveCommand();
+void processLogLevelCommand();
+void processCaptureCommand();
 
 #endif // SERIAL_COMMANDS_H
@@ -1,8 +1,15 @@
 #include "servo_controller.h"
+#include "utils/dcc_address_index.h"
+#include "core/servo_command_queue.h"
+#include "core/servo_move_scheduler.h"
+#include "core/event_bus.h"
+#include "utils/servo_easing.h"
+#include "hardware/servo_output.h"
+#include "utils/servo_state_log.h"
+#include "utils/diag_log.h"
 
 // Global servo arrays
 VIRTUALSERVO virtualservo[TOTAL_PINS];
-VIRTUALSERVO *vsBoot = nullptr;
 Servo servoDriver[TOTAL_PINS];
 
 // ESP32 PWM pins array - Using valid ESP32 servo pins only
@@ -42,10 +49,253 @@ bool isValidOffset(int8_t offset, uint8_t swing) {
     return (abs(offset) <= maxAllowed);
 }
 
+// Map a speed setting onto degrees per second. Settings 0-3 select the
+// Instant/Fast/Normal/Slow presets, anything else is taken as degrees/second.
+uint16_t getServoSpeedPreset(uint8_t preset) {
+    switch (preset) {
+        case SPEED_FAST: return SERVO_SPEED_FAST_DPS;
+        case SPEED_NORMAL: return SERVO_SPEED_NORMAL_DPS;
+        case SPEED_SLOW: return SERVO_SPEED_SLOW_DPS;
+        default: return 0;  // Instant
+    }
+}
+
+bool parseServoSpeed(long value, uint16_t &speed) {
+    if (value < 0 || value > SERVO_MAX_SPEED_DPS) {
+        return false;
+    }
+    speed = (value < SPEED_PRESET_COUNT) ? getServoSpeedPreset(value) : (uint16_t)value;
+    return true;
+}
+
+// Preset name for a speed, or nullptr for an explicit degrees/second value
+const char* getServoSpeedName(uint16_t speed) {
+    switch (speed) {
+        case 0: return "Instant";
+        case SERVO_SPEED_FAST_DPS: return "Fast";
+        case SERVO_SPEED_NORMAL_DPS: return "Normal";
+        case SERVO_SPEED_SLOW_DPS: return "Slow";
+        default: return nullptr;
+    }
+}
+
+// Aspects 0 and 1 default to closed and thrown, so a two-position arm answers
+// extended (signal aspect) packets without any setup
+void setDefaultServoAspects(uint8_t *aspects) {
+    aspects[0] = 0;
+    aspects[1] = 100;
+    for (uint8_t n = 2; n < SERVO_ASPECT_COUNT; n++) {
+        aspects[n] = SERVO_ASPECT_UNUSED;
+    }
+}
+
+// Parse an aspect table: "p0,p1,..." in percent of travel from closed (0) to
+// thrown (100), '-' for an unused aspect. Aspects not listed are unused.
+// The table is only changed if the whole text is valid.
+bool parseServoAspects(const char *text, uint8_t *aspects) {
+    uint8_t parsed[SERVO_ASPECT_COUNT];
+    memset(parsed, SERVO_ASPECT_UNUSED, sizeof(parsed));
+    uint8_t n = 0;
+    
+    while (*text == ' ') text++;
+    while (*text != '\0') {
+        if (n >= SERVO_ASPECT_COUNT) return false;
+        if (*text == '-') {
+            text++;
+        } else {
+            char *end;
+            long percent = strtol(text, &end, 10);
+            if ((end == text) || (percent < 0) || (percent > 100)) return false;
+            parsed[n] = (uint8_t)percent;
+            text = end;
+        }
+        n++;
+        
+        while (*text == ' ') text++;
+        if (*text == ',') {
+            text++;
+            while (*text == ' ') text++;
+        } else if (*text != '\0') {
+            return false;
+        }
+    }
+    
+    memcpy(aspects, parsed, sizeof(parsed));
+    return true;
+}
+
+// Format an aspect table the way parseServoAspects() reads it, trailing unused
+// aspects left out. Returns the length (0 when no aspect is in use).
+size_t formatServoAspects(const uint8_t *aspects, char *buffer, size_t size) {
+    uint8_t count = SERVO_ASPECT_COUNT;
+    while ((count > 0) && (aspects[count - 1] == SERVO_ASPECT_UNUSED)) count--;
+    
+    size_t length = 0;
+    buffer[0] = '\0';
+    for (uint8_t n = 0; n < count && length < size; n++) {
+        int written = (aspects[n] == SERVO_ASPECT_UNUSED)
+            ? snprintf(buffer + length, size - length, "%s-", n ? "," : "")
+            : snprintf(buffer + length, size - length, "%s%u", n ? "," : "", aspects[n]);
+        if (written < 0) break;
+        length += written;
+    }
+    return (length < size) ? length : size - 1;
+}
+
+// Runtime motion state, kept out of VIRTUALSERVO so it is never persisted.
+// Pulse widths are fixed point: microseconds << SERVO_PULSE_FRAC_BITS.
+struct ServoMotion {
+    uint32_t pulse;         // Current output
+    uint32_t startPulse;    // Where the current move began
+    uint32_t targetPulse;   // Where the current move ends
+    uint32_t elapsedUs;     // Time spent on the current move
+    uint32_t durationUs;    // Total time for the current move at the servo's speed
+    
+    // Endpoints, cached by refreshServoConfig()
+    uint32_t closedPulse;
+    uint32_t thrownPulse;
+    uint32_t centerPulse;
+    uint32_t aspectPulse[SERVO_ASPECT_COUNT];  // 0 = unused aspect
+    
+    uint8_t aspect;         // Signal aspect being moved to or held
+};
+
+static ServoMotion servoMotion[TOTAL_PINS];
+static uint32_t lastUpdateUs = 0;
+
+// Servos with work to do on the next tick (bit n = virtualservo[n]). Set when a
+// command or configuration change arrives, cleared once a move has finished and
+// any detach is done, so idle servos cost nothing per tick.
+static uint16_t activeServos = 0;
+
+// Last state published on the event bus, so only transitions are pushed
+static uint8_t publishedState[TOTAL_PINS];
+
+// Boot scheduler: servos in SERVO_BOOT are driven to their closed position in
+// groups of SERVO_BOOT_GROUP_SIZE, each group held for SERVO_BOOT_HOLD_MS
+static uint16_t bootingServos = 0;      // Servos in the current group
+static uint32_t bootGroupStartUs = 0;
+static uint32_t bootGroupReleaseUs = 0;
+static uint32_t bootStartUs = 0;        // First boot tick, 0 when no boot is running
+static ServoBootReport bootReport = {0, 0, 0, 0, false};
+
+// Servos that boot to thrown: the states last saved by servoStateLog. Cleared
+// once the boot is done, so a later boot (factory reset) closes every servo.
+static uint16_t bootThrownMask = 0;
+
+// Settled state of each servo (bit set = thrown), written to flash by servoStateLog
+static volatile uint16_t settledThrownMask = 0;
+
+// Settled pulse widths retained across warm resets (watchdog, brownout, restart).
+// RTC memory is not cleared by a reset but holds garbage after power-on, so the
+// block is only trusted when its magic and checksum match.
+#define SERVO_RETAINED_MAGIC 0x53525650UL
+struct RetainedServoPositions {
+    uint32_t magic;
+    uint32_t settledPulse[TOTAL_PINS];   // 0 = moving or unknown
+    uint32_t checksum;
+};
+
+static RTC_NOINIT_ATTR RetainedServoPositions retainedPositions;
+
+static uint32_t retainedChecksum() {
+    uint32_t sum = retainedPositions.magic;
+    for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+        sum = (sum << 5 | sum >> 27) ^ retainedPositions.settledPulse[i];
+    }
+    return sum;
+}
+
+static void retainSettledPulse(uint8_t i, uint32_t pulse) {
+    if (retainedPositions.settledPulse[i] == pulse) return;
+    retainedPositions.settledPulse[i] = pulse;
+    retainedPositions.checksum = retainedChecksum();
+}
+
+static const uint32_t SERVO_PULSE_MIN_FP = (uint32_t)SERVO_MIN_PULSE_US << SERVO_PULSE_FRAC_BITS;
+static const uint32_t SERVO_PULSE_RANGE_FP = (uint32_t)(SERVO_MAX_PULSE_US - SERVO_MIN_PULSE_US) << SERVO_PULSE_FRAC_BITS;
+
+static uint32_t degreesToPulse(int16_t degrees) {
+    if (degrees < 0) degrees = 0;
+    if (degrees > 180) degrees = 180;
+    return SERVO_PULSE_MIN_FP + (uint32_t)degrees * SERVO_PULSE_RANGE_FP / 180;
+}
+
+static uint8_t pulseToDegrees(uint32_t pulse) {
+    // Overshooting easing profiles can briefly leave the 0-180 degree range
+    if (pulse <= SERVO_PULSE_MIN_FP) return 0;
+    if (pulse >= SERVO_PULSE_MIN_FP + SERVO_PULSE_RANGE_FP) return 180;
+    return (uint8_t)(((pulse - SERVO_PULSE_MIN_FP) * 180 + SERVO_PULSE_RANGE_FP / 2) / SERVO_PULSE_RANGE_FP);
+}
+
+static uint16_t pulseToMicroseconds(uint32_t pulse) {
+    return (uint16_t)((pulse + (1U << (SERVO_PULSE_FRAC_BITS - 1))) >> SERVO_PULSE_FRAC_BITS);
+}
+
+// Hold a servo at a pulse with no move in progress
+static void holdPulse(ServoMotion &motion, uint32_t pulse) {
+    motion.pulse = pulse;
+    motion.startPulse = pulse;
+    motion.targetPulse = pulse;
+    motion.elapsedUs = 0;
+    motion.durationUs = 0;
+}
+
+// Advance a servo toward `target` along its easing profile. A new target (command,
+// direction change or configuration change) starts a new move from the current
+// output. Returns true once the target is reached.
+static bool stepTowards(ServoMotion &motion, uint32_t target, const VIRTUALSERVO &vs, uint32_t elapsedUs) {
+    if (vs.speed == 0) {
+        holdPulse(motion, target);
+        return true;
+    }
+    
+    if (motion.targetPulse != target) {
+        uint32_t distance = (motion.pulse > target) ? motion.pulse - target : target - motion.pulse;
+        motion.startPulse = motion.pulse;
+        motion.targetPulse = target;
+        motion.elapsedUs = 0;
+        motion.durationUs = (uint32_t)(((uint64_t)distance * 180ULL * 1000000ULL) /
+                                       ((uint64_t)vs.speed * SERVO_PULSE_RANGE_FP));
+    }
+    
+    motion.elapsedUs += elapsedUs;
+    if (motion.elapsedUs >= motion.durationUs) {
+        holdPulse(motion, target);
+        return true;
+    }
+    
+    uint32_t progress = (uint32_t)(((uint64_t)motion.elapsedUs << SERVO_EASING_PROGRESS_BITS) / motion.durationUs);
+    int64_t delta = (int64_t)target - (int64_t)motion.startPulse;
+    int64_t eased = (delta * evaluateServoEasing(vs.easing, progress)) >> SERVO_EASING_FRAC_BITS;
+    motion.pulse = (uint32_t)((int64_t)motion.startPulse + eased);
+    return false;
+}
+
+// Jump a servo straight to a position (no motion), keeping the motion engine in step
+void setServoPosition(VIRTUALSERVO &vs, uint8_t degrees) {
+    uint8_t index = &vs - virtualservo;
+    vs.position = degrees;
+    holdPulse(servoMotion[index], degreesToPulse(degrees));
+    activeServos |= 1U << index;
+}
+
+uint16_t getActiveServoMask() {
+    return activeServos;
+}
+
+uint16_t getSettledThrownMask() {
+    return settledThrownMask;
+}
+
+// Aspect a servo in SERVO_TO_ASPECT or SERVO_ASPECT is moving to or holding
+uint8_t getServoAspect(uint8_t servo) {
+    return servoMotion[servo].aspect;
+}
+
 // Global timing variables
 unsigned long currentMs;
 unsigned long previousMs;
-uint8_t bootTimer = 0;
 uint8_t tick;
 bool ledState;
 
@@ -55,114 +305,322 @@ void initializeServos() {
     ESP32PWM::allocateTimer(1);
     ESP32PWM::allocateTimer(2);
     ESP32PWM::allocateTimer(3);
+    
+    // Positions left by a warm reset let the boot sequence skip settled servos
+    if ((retainedPositions.magic != SERVO_RETAINED_MAGIC) || (retainedPositions.checksum != retainedChecksum())) {
+        retainedPositions.magic = SERVO_RETAINED_MAGIC;
+        for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+            retainedPositions.settledPulse[i] = 0;
+        }
+        retainedPositions.checksum = retainedChecksum();
+    }
+    
+    // Turnouts go back to where they were last left, so the boot moves nothing
+    // that a train may be standing on
+    if (servoStateLog.begin(SERVO_STATE_PARTITION) && servoStateLog.hasState()) {
+        bootThrownMask = servoStateLog.getState();
+        DIAG_INFO("Servo states restored: %u thrown", __builtin_popcount(bootThrownMask));
+    }
+    settledThrownMask = bootThrownMask;
+    
+    // No state published yet, so the first tick pushes every servo's state
+    memset(publishedState, 0xFF, sizeof(publishedState));
+    
+    lastUpdateUs = micros();
 }
 
-void updateServos() {
-    // Update all moving servos every 15mS
+const ServoBootReport &getServoBootReport() {
+    return bootReport;
+}
+
+// Rebuild everything derived from the servo configuration.
+// Must be called after any change to virtualservo[] settings.
+void refreshServoConfig() {
+    uint16_t addresses[TOTAL_PINS];
+    for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+        addresses[i] = virtualservo[i].address;
+    }
+    dccAddressIndex.rebuild(addresses, TOTAL_PINS);
+    
+    // Endpoints only change with the configuration, so the tick never recomputes them.
     // In normal non-invert mode, minPosition is turnout closed, and maxPosition is turnout thrown
-    for (auto &vs : virtualservo) {
-        uint8_t centerPosition = 90 + vs.offset;  // Apply offset to center position
-        uint8_t maxPosition = centerPosition + vs.swing;
-        uint8_t minPosition = centerPosition - vs.swing;
+    for (uint8_t i = 0; i < TOTAL_PINS; i++) {
+        const VIRTUALSERVO &vs = virtualservo[i];
+        int16_t centerPosition = SERVO_CENTER_POSITION + vs.offset;  // Apply offset to center position
+        uint32_t maxPulse = degreesToPulse(centerPosition + vs.swing);
+        uint32_t minPulse = degreesToPulse(centerPosition - vs.swing);
+        servoMotion[i].closedPulse = vs.invert ? maxPulse : minPulse;
+        servoMotion[i].thrownPulse = vs.invert ? minPulse : maxPulse;
+        servoMotion[i].centerPulse = degreesToPulse(centerPosition);
         
-        switch (vs.state) {
-        case SERVO_NEUTRAL:
-            vs.position = centerPosition;  // Use offset center position
-            if (!vs.thisDriver->attached()) vs.thisDriver->attach(vs.pin);
-            break;
-            
-        case SERVO_TO_CLOSED:
-            // Swing toward minPosition, unless invert is true
-            if (vs.invert) {
-                if (vs.speed == SPEED_INSTANT) {
-                    vs.position = maxPosition;
-                } else {
-                    uint8_t step = (vs.speed == SPEED_FAST) ? 3 : (vs.speed == SPEED_NORMAL) ? 2 : 1;
-                    uint8_t remaining = (vs.position < maxPosition) ? (maxPosition - vs.position) : 0;
-                    vs.position += (remaining > 0) ? (step < remaining ? step : remaining) : 0;
-                }
-            } else {
-                if (vs.speed == SPEED_INSTANT) {
-                    vs.position = minPosition;
-                } else {
-                    uint8_t step = (vs.speed == SPEED_FAST) ? 3 : (vs.speed == SPEED_NORMAL) ? 2 : 1;
-                    uint8_t remaining = (vs.position > minPosition) ? (vs.position - minPosition) : 0;
-                    vs.position -= (remaining > 0) ? (step < remaining ? step : remaining) : 0;
-                }
-            }
+        // Aspect positions too, so an aspect command costs no more than a turnout command
+        ServoMotion &motion = servoMotion[i];
+        int32_t travel = (int32_t)motion.thrownPulse - (int32_t)motion.closedPulse;
+        for (uint8_t n = 0; n < SERVO_ASPECT_COUNT; n++) {
+            uint8_t percent = vs.aspects[n];
+            motion.aspectPulse[n] = (percent > 100) ? 0 : (uint32_t)((int32_t)motion.closedPulse + travel * percent / 100);
+        }
         
-            if ((vs.position == maxPosition) || (vs.position == minPosition)) {
-                vs.state = SERVO_CLOSED;
-            }
+        // An aspect taken out of the table while in use falls back to closed
+        if (((vs.state == SERVO_TO_ASPECT) || (vs.state == SERVO_ASPECT)) && (motion.aspectPulse[motion.aspect] == 0)) {
+            virtualservo[i].state = SERVO_TO_CLOSED;
+        }
+    }
+    
+    // Let every servo pick up its new endpoints
+    activeServos = (1U << TOTAL_PINS) - 1;
+}
+
+// Apply a queued command to one servo
+static void applyServoCommand(uint8_t i, uint8_t target) {
+    VIRTUALSERVO &vs = virtualservo[i];
+    
+    switch (target) {
+    case SERVO_CMD_CLOSE:
+        vs.state = SERVO_TO_CLOSED;
+        break;
+    case SERVO_CMD_THROW:
+        vs.state = SERVO_TO_THROWN;
+        break;
+    case SERVO_CMD_NEUTRAL:
+        vs.state = SERVO_NEUTRAL;
+        break;
+    case SERVO_CMD_TOGGLE:
+        vs.state = (vs.state == SERVO_CLOSED) ? SERVO_TO_THROWN : SERVO_TO_CLOSED;
+        break;
+    default: {
+        // Signal aspect: ignored unless the servo's table has a position for it
+        uint8_t aspect = target - SERVO_CMD_ASPECT;
+        if ((aspect < SERVO_ASPECT_COUNT) && (servoMotion[i].aspectPulse[aspect] != 0)) {
+            servoMotion[i].aspect = aspect;
+            vs.state = SERVO_TO_ASPECT;
+        }
+        break;
+    }
+    }
+}
 
-            if (!vs.thisDriver->attached()) vs.thisDriver->attach(vs.pin);
-            break;
+// Pulse a moving servo is heading for. Returns false if it is not moving.
+static bool getMoveTarget(uint8_t i, uint32_t &targetPulse) {
+    const ServoMotion &motion = servoMotion[i];
+    
+    switch (virtualservo[i].state) {
+    case SERVO_TO_CLOSED:
+        targetPulse = motion.closedPulse;
+        return true;
+    case SERVO_TO_THROWN:
+        targetPulse = motion.thrownPulse;
+        return true;
+    case SERVO_TO_ASPECT:
+        targetPulse = motion.aspectPulse[motion.aspect];
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Drain the command queue in arrival order. A servo commanded more than once
+// in the same tick ends on its last command; the earlier ones count as coalesced.
+static void drainServoCommands() {
+    ServoCommand command;
+    uint16_t commandedThisTick = 0;
+    
+    while (servoCommandQueue.pop(command)) {
+        uint16_t mask = command.servoMask;
+        servoCommandQueue.addCoalesced(__builtin_popcount(mask & commandedThisTick));
+        commandedThisTick |= mask;
         
-        case SERVO_TO_THROWN:
-            // Swing toward maxPosition unless invert is true
-            if (vs.invert) {
-                if (vs.speed == SPEED_INSTANT) {
-                    vs.position = minPosition;
-                } else {
-                    uint8_t step = (vs.speed == SPEED_FAST) ? 3 : (vs.speed == SPEED_NORMAL) ? 2 : 1;
-                    uint8_t remaining = (vs.position > minPosition) ? (vs.position - minPosition) : 0;
-                    vs.position -= (remaining > 0) ? (step < remaining ? step : remaining) : 0;
-                }
+        uint8_t target = command.target & SERVO_CMD_TARGET_MASK;
+        bool priority = command.target & SERVO_CMD_PRIORITY;
+        
+        activeServos |= mask;
+        while (mask) {
+            uint8_t i = __builtin_ctz(mask);
+            mask &= mask - 1;
+            
+            applyServoCommand(i, target);
+            
+            // Queue for a move slot in arrival order. Servos already at the
+            // target (common in "set all" bursts) settle without one.
+            uint32_t targetPulse;
+            if (getMoveTarget(i, targetPulse) && (servoMotion[i].pulse != targetPulse)) {
+                servoMoveScheduler.request(i, priority);
             } else {
-                if (vs.speed == SPEED_INSTANT) {
-                    vs.position = maxPosition;
-                } else {
-                    uint8_t step = (vs.speed == SPEED_FAST) ? 3 : (vs.speed == SPEED_NORMAL) ? 2 : 1;
-                    uint8_t remaining = (vs.position < maxPosition) ? (maxPosition - vs.position) : 0;
-                    vs.position += (remaining > 0) ? (step < remaining ? step : remaining) : 0;
-                }
+                servoMoveScheduler.release(i);
             }
+        }
+    }
+}
 
-            if ((vs.position == maxPosition) || (vs.position == minPosition)) {
-                vs.state = SERVO_THROWN;
-            }
+// Run one servo's state machine. Returns true while it still needs ticks.
+static bool updateServo(uint8_t i, uint32_t elapsedUs) {
+    VIRTUALSERVO &vs = virtualservo[i];
+    ServoMotion &motion = servoMotion[i];
+    bool active = false;
+    
+    switch (vs.state) {
+    case SERVO_NEUTRAL:
+        servoMoveScheduler.release(i);
+        holdPulse(motion, motion.centerPulse);  // Use offset center position
+        if (!servoOutput.attached(i)) servoOutput.attach(i, vs.pin);
+        break;
+        
+    case SERVO_TO_CLOSED:
+        // Swing toward minPosition, unless invert is true
+        if ((motion.pulse != motion.closedPulse) && !servoMoveScheduler.request(i, false)) {
+            break;  // Waiting for a move slot; admit() reactivates it
+        }
+        retainSettledPulse(i, 0);
+        if (stepTowards(motion, motion.closedPulse, vs, elapsedUs)) {
+            vs.state = SERVO_CLOSED;
+        }
+        if (!servoOutput.attached(i)) servoOutput.attach(i, vs.pin);
+        active = true;  // Settle (and detach) on the next tick
+        break;
+    
+    case SERVO_TO_THROWN:
+        // Swing toward maxPosition unless invert is true
+        if ((motion.pulse != motion.thrownPulse) && !servoMoveScheduler.request(i, false)) {
+            break;  // Waiting for a move slot; admit() reactivates it
+        }
+        retainSettledPulse(i, 0);
+        if (stepTowards(motion, motion.thrownPulse, vs, elapsedUs)) {
+            vs.state = SERVO_THROWN;
+        }
+        if (!servoOutput.attached(i)) servoOutput.attach(i, vs.pin);
+        active = true;
+        break;
 
-            if (!vs.thisDriver->attached()) vs.thisDriver->attach(vs.pin);
-            break;
+    case SERVO_TO_ASPECT:
+        // Same as a turnout move, to the precomputed aspect position
+        if ((motion.pulse != motion.aspectPulse[motion.aspect]) && !servoMoveScheduler.request(i, false)) {
+            break;  // Waiting for a move slot; admit() reactivates it
+        }
+        retainSettledPulse(i, 0);
+        if (stepTowards(motion, motion.aspectPulse[motion.aspect], vs, elapsedUs)) {
+            vs.state = SERVO_ASPECT;
+        }
+        if (!servoOutput.attached(i)) servoOutput.attach(i, vs.pin);
+        active = true;
+        break;
 
-        case SERVO_THROWN:
-            vs.position = vs.invert ? minPosition : maxPosition;
-            if ((vs.thisDriver->attached()) && (!vs.continuous)) {
-                vs.thisDriver->detach();
-            }
-            break;
-            
-        case SERVO_CLOSED:
-            vs.position = vs.invert ? maxPosition : minPosition;
-            if ((vs.thisDriver->attached()) && (!vs.continuous)) {
-                vs.thisDriver->detach();
-            }
-            break;
-
-        case SERVO_BOOT:
-            if (vsBoot == nullptr) {
-                // Handle next-up servo to boot. Servos are booted in the CLOSED position
-                vsBoot = &vs;
-                bootTimer = 34;
-                vs.position = vs.invert ? maxPosition : minPosition;
-                if (!vs.thisDriver->attached()) vs.thisDriver->attach(vs.pin);
-                vs.thisDriver->write(vs.position);
-            } else if (vsBoot == &vs) { 
-                // If this is the current boot-servo, then decrement bootTimer
-                bootTimer -= bootTimer > 0 ? 1 : 0;
-                
-                // Timed out?
-                if (bootTimer == 0) {
-                    vs.state = SERVO_CLOSED;
-                    Serial.print("pin booted: ");
-                    Serial.println(vs.pin, DEC);
-                    // Release for next vs to boot
-                    vsBoot = nullptr;
-                }
+    case SERVO_THROWN:
+        servoMoveScheduler.release(i);
+        holdPulse(motion, motion.thrownPulse);
+        retainSettledPulse(i, motion.pulse);
+        settledThrownMask |= 1U << i;
+        if ((servoOutput.attached(i)) && (!vs.continuous)) {
+            servoOutput.detach(i);
+        }
+        break;
+        
+    case SERVO_CLOSED:
+        servoMoveScheduler.release(i);
+        holdPulse(motion, motion.closedPulse);
+        retainSettledPulse(i, motion.pulse);
+        settledThrownMask &= ~(1U << i);
+        if ((servoOutput.attached(i)) && (!vs.continuous)) {
+            servoOutput.detach(i);
+        }
+        break;
+
+    case SERVO_ASPECT:
+        // Aspects are not restored at boot: the servo boots closed
+        servoMoveScheduler.release(i);
+        holdPulse(motion, motion.aspectPulse[motion.aspect]);
+        retainSettledPulse(i, motion.pulse);
+        settledThrownMask &= ~(1U << i);
+        if ((servoOutput.attached(i)) && (!vs.continuous)) {
+            servoOutput.detach(i);
+        }
+        break;
+
+    case SERVO_BOOT: {
+        // Servos are booted in their last settled position, CLOSED if none was saved
+        bool bootThrown = (bootThrownMask & (1U << i)) != 0;
+        uint32_t bootPulse = bootThrown ? motion.thrownPulse : motion.closedPulse;
+        servoMoveScheduler.release(i);
+        active = true;  // Until booted
+        if (bootStartUs == 0) {
+            bootStartUs = lastUpdateUs;
+            bootReport = {0, 0, 0, 0, false};
+        }
+        
+        if (bootingServos & (1U << i)) {
+            // Member of the running group - release once the hold time is up
+            if (lastUpdateUs - bootGroupStartUs >= SERVO_BOOT_HOLD_MS * 1000UL) {
+                vs.state = bootThrown ? SERVO_THROWN : SERVO_CLOSED;
+                bootingServos &= ~(1U << i);
+                bootGroupReleaseUs = lastUpdateUs;
+                bootReport.booted++;
+                if (bootThrown) bootReport.thrown++;
             }
-            break;
+        } else if (retainedPositions.settledPulse[i] == bootPulse) {
+            // Still in place from before a warm reset - nothing to drive
+            holdPulse(motion, bootPulse);
+            vs.state = bootThrown ? SERVO_THROWN : SERVO_CLOSED;
+            bootReport.skipped++;
+            if (bootThrown) bootReport.thrown++;
+        } else if (((bootingServos == 0) && (bootGroupReleaseUs != lastUpdateUs)) ||
+                   ((bootGroupStartUs == lastUpdateUs) && (__builtin_popcount(bootingServos) < SERVO_BOOT_GROUP_SIZE))) {
+            // Start a new group once the previous one has been released for a
+            // tick (and detached), or join the group started this tick
+            if (bootingServos == 0) bootGroupStartUs = lastUpdateUs;
+            bootingServos |= 1U << i;
+            holdPulse(motion, bootPulse);
+            retainSettledPulse(i, 0);
+            if (!servoOutput.attached(i)) servoOutput.attach(i, vs.pin);
         }
+        break;
+    }
+    }
 
-        vs.thisDriver->write(vs.position);
+    vs.position = pulseToDegrees(motion.pulse);
+    servoOutput.writeMicroseconds(i, pulseToMicroseconds(motion.pulse));
+    
+    if (vs.state != publishedState[i]) {
+        publishedState[i] = vs.state;
+        eventBus.publish(BUS_EVENT_SERVO_STATE, i, vs.state);
+    }
+    return active;
+}
+
+void updateServos() {
+    drainServoCommands();
+    
+    // Motion is driven by elapsed time, so a late tick moves servos further
+    // rather than stretching the travel time
+    uint32_t nowUs = micros();
+    uint32_t elapsedUs = nowUs - lastUpdateUs;
+    lastUpdateUs = nowUs;
+    
+    // Visit only the active servos
+    uint16_t pending = activeServos;
+    bool booting = false;
+    while (pending) {
+        uint8_t i = __builtin_ctz(pending);
+        pending &= pending - 1;
+        
+        if (!updateServo(i, elapsedUs)) {
+            activeServos &= ~(1U << i);
+        }
+        booting |= (virtualservo[i].state == SERVO_BOOT);
+    }
+    
+    if ((bootStartUs != 0) && !booting) {
+        bootReport.durationMs = (nowUs - bootStartUs) / 1000;
+        bootReport.complete = true;
+        bootStartUs = 0;
+        bootThrownMask = 0;
+#if SERVO_BOOT_REPORT
+        DIAG_INFO("Servos booted: %u driven, %u already in place, %u restored to thrown, %lu ms",
+                  bootReport.booted, bootReport.skipped, bootReport.thrown, (unsigned long)bootReport.durationMs);
+#endif
     }
+    
+    // Hand slots freed this tick to waiting servos; they start moving next tick
+    activeServos |= servoMoveScheduler.admit();
+    
+    // One batch of driver updates, changed channels only
+    servoOutput.commit();
 }
@@ -11,34 +11,49 @@ enum servoState {
     SERVO_THROWN,
     SERVO_TO_CLOSED,
     SERVO_CLOSED,
-    SERVO_BOOT
+    SERVO_BOOT,
+    SERVO_TO_ASPECT,    // Moving to a signal aspect position
+    SERVO_ASPECT        // Holding a signal aspect position
 };
 
-// Servo speeds
+// Servo speed presets. Speed settings below SPEED_PRESET_COUNT select a preset,
+// larger values are taken as degrees per second.
 enum servoSpeed {
     SPEED_INSTANT = 0,  // Move immediately to target position
-    SPEED_FAST = 1,     // Move 3 degrees per update (45ms total for 45° swing)
-    SPEED_NORMAL = 2,   // Move 2 degrees per update (67.5ms total for 45° swing)  
-    SPEED_SLOW = 3      // Move 1 degree per update (135ms total for 45° swing)
+    SPEED_FAST = 1,     // SERVO_SPEED_FAST_DPS (~225ms for 45° swing)
+    SPEED_NORMAL = 2,   // SERVO_SPEED_NORMAL_DPS (~340ms for 45° swing)
+    SPEED_SLOW = 3,     // SERVO_SPEED_SLOW_DPS (~670ms for 45° swing)
+    SPEED_PRESET_COUNT = 4
 };
 
 // Virtual servo structure
+// Stored through the tagged servo record (settings_layouts.h), not as laid out here.
 struct VIRTUALSERVO {
     uint8_t pin;
+    uint8_t easing;     // Motion profile (servoEasing)
     uint16_t address;
     uint8_t swing;
     int8_t offset;      // Offset from center position (-45 to +45 degrees)
-    uint8_t speed;      // Movement speed (servoSpeed enum)
     bool invert;
     bool continuous;
     uint8_t state;
-    uint8_t position;
+    uint8_t position;   // Current position in whole degrees (for display)
+    uint16_t speed;     // Movement speed in degrees per second (0 = instant)
+    uint8_t aspects[SERVO_ASPECT_COUNT];  // Signal aspect positions, % of travel closed->thrown (or SERVO_ASPECT_UNUSED)
     Servo *thisDriver;
 };
 
+// Outcome of the last boot sequence
+struct ServoBootReport {
+    uint8_t booted;       // Servos driven to their last settled position
+    uint8_t skipped;      // Servos still in place from before a warm reset
+    uint8_t thrown;       // Servos restored to thrown (driven or skipped)
+    uint32_t durationMs;  // First boot tick to last servo released
+    bool complete;
+};
+
 // Global servo arrays
 extern VIRTUALSERVO virtualservo[TOTAL_PINS];
-extern VIRTUALSERVO *vsBoot;
 extern Servo servoDriver[TOTAL_PINS];
 
 // ESP32 PWM pins array
@@ -48,6 +63,16 @@ extern const uint8_t pwmPins[TOTAL_PINS];
 uint8_t getGpioPinFromServoNumber(uint8_t servoNumber);
 int8_t getServoNumberFromGpioPin(uint8_t gpioPin);
 
+// Speed helpers
+uint16_t getServoSpeedPreset(uint8_t preset);
+bool parseServoSpeed(long value, uint16_t &speed);
+const char* getServoSpeedName(uint16_t speed);
+
+// Signal aspect table helpers
+void setDefaultServoAspects(uint8_t *aspects);
+bool parseServoAspects(const char *text, uint8_t *aspects);
+size_t formatServoAspects(const uint8_t *aspects, char *buffer, size_t size);
+
 // Offset validation function
 uint8_t getMaxAllowedOffset(uint8_t swing);
 bool isValidOffset(int8_t offset, uint8_t swing);
@@ -55,13 +80,18 @@ bool isValidOffset(int8_t offset, uint8_t swing);
 // Global timing variables
 extern unsigned long currentMs;
 extern unsigned long previousMs;
-extern uint8_t bootTimer;
 extern uint8_t tick;
 extern bool ledState;
 
 // Function declarations
 void initializeServos();
 void updateServos();
+void refreshServoConfig();
 void moveServoToPosition(VIRTUALSERVO* vs, uint8_t targetPosition);
+void setServoPosition(VIRTUALSERVO &vs, uint8_t degrees);
+uint16_t getActiveServoMask();
+uint16_t getSettledThrownMask();
+uint8_t getServoAspect(uint8_t servo);
+const ServoBootReport &getServoBootReport();
 
 #endif // SERVO_CONTROLLER_H
@@ -0,0 +1,190 @@
+#ifndef SETTINGS_LAYOUTS_H
+#define SETTINGS_LAYOUTS_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "wifi_controller.h"
+
+/*
+ * Settings image layouts
+ *
+ * Since v0.5.0 the EEPROM image is a store header followed by tagged records,
+ * each with its own layout version and a CRC-32:
+ *
+ *   [SettingsStoreHeader][SettingsRecordHeader][payload]...[SettingsRecordHeader tag END]
+ *
+ * Records are always written at the addresses below, in the current version,
+ * but are read by walking the stored lengths, so an image written with older
+ * record versions still parses. Each record version has a decoder in
+ * eeprom_manager.cpp; anything not in the current version is rewritten after
+ * loading.
+ *
+ * Releases before v0.5.0 stored the structs themselves, untagged, as laid out
+ * by the ESP32 compiler. Those layouts are spelled out here with fixed-width
+ * fields so they can be read (and, on the host, written) byte for byte; their
+ * servo and WiFi parts are decoded as record versions 1 and 1-2.
+ */
+
+#define SETTINGS_STORE_MAGIC 0x47464353UL  // "SCFG"; not a valid version number of the untagged layouts
+
+enum SettingsTag : uint8_t {
+    SETTINGS_TAG_END = 0,
+    SETTINGS_TAG_CONTROLLER = 1,
+    SETTINGS_TAG_SERVOS = 2,
+    SETTINGS_TAG_WIFI = 3,
+    SETTINGS_TAG_DCC = 4
+};
+
+// Current record versions
+#define CONTROLLER_RECORD_VERSION 1
+#define SERVO_RECORD_VERSION 2
+#define WIFI_RECORD_VERSION 3
+#define DCC_RECORD_VERSION 1
+
+struct SettingsStoreHeader {
+    uint32_t magic;         // SETTINGS_STORE_MAGIC
+};
+
+struct SettingsRecordHeader {
+    uint8_t tag;            // SettingsTag
+    uint8_t version;        // Layout of the payload
+    uint16_t length;        // Payload bytes that follow
+    uint32_t crc;           // CRC-32 of tag, version, length and payload
+};
+
+// Controller record v1
+struct ControllerRecordV1 {
+    int32_t softwareVersion;  // NUMERIC_VERSION of the firmware that wrote the settings
+};
+
+// DCC record v1: addressing mode (DccAddressing)
+struct DccRecordV1 {
+    uint8_t mode;           // DccAddressMode
+    uint8_t shift;          // Station address shift, 0 or 4
+    uint16_t boardBase;     // First board of the block in board mode
+};
+
+// Servo record v2: one entry per servo, in pin order
+struct ServoRecordV2 {
+    uint16_t address;
+    uint16_t speed;         // Degrees per second (0 = instant)
+    uint8_t swing;
+    int8_t offset;
+    uint8_t easing;
+    uint8_t flags;          // SERVO_RECORD_INVERT | SERVO_RECORD_CONTINUOUS
+    uint8_t aspects[SERVO_ASPECT_COUNT];  // % of travel closed->thrown, SERVO_ASPECT_UNUSED = none
+};
+
+#define SERVO_RECORD_INVERT 0x01
+#define SERVO_RECORD_CONTINUOUS 0x02
+
+// WiFi record v3
+struct WiFiRecordV3 {
+    uint8_t enabled;
+    uint8_t mode;           // DccWiFiMode
+    uint8_t useStaticIP;
+    uint8_t reserved;
+    char stationSSID[WIFI_SSID_MAX_LENGTH];
+    char stationPassword[WIFI_PASSWORD_MAX_LENGTH];
+    char apSSID[WIFI_SSID_MAX_LENGTH];
+    char apPassword[WIFI_PASSWORD_MAX_LENGTH];
+    char hostname[WIFI_HOSTNAME_MAX_LENGTH];
+    uint8_t staticIP[4];
+    uint8_t gateway[4];
+    uint8_t subnet[4];
+    uint8_t dns1[4];
+    uint8_t dns2[4];
+};
+
+// Where the current layout puts each record
+#define SETTINGS_CONTROLLER_ADDRESS (sizeof(SettingsStoreHeader))
+#define SETTINGS_DCC_ADDRESS (SETTINGS_CONTROLLER_ADDRESS + sizeof(SettingsRecordHeader) + sizeof(ControllerRecordV1))
+#define SETTINGS_SERVOS_ADDRESS (SETTINGS_DCC_ADDRESS + sizeof(SettingsRecordHeader) + sizeof(DccRecordV1))
+#define SETTINGS_WIFI_ADDRESS (SETTINGS_SERVOS_ADDRESS + sizeof(SettingsRecordHeader) + sizeof(ServoRecordV2) * TOTAL_PINS)
+#define SETTINGS_END_ADDRESS (SETTINGS_WIFI_ADDRESS + sizeof(SettingsRecordHeader) + sizeof(WiFiRecordV3))
+
+static_assert(SETTINGS_END_ADDRESS + sizeof(SettingsRecordHeader) <= EEPROM_COMMIT_COUNT_ADDRESS,
+              "Settings records overlap the EEPROM commit counter");
+
+// ---------------------------------------------------------------------------
+// Untagged layouts of v0.4.0 - v0.4.3: controller, servo array, WiFi config
+// ---------------------------------------------------------------------------
+
+#define LEGACY_LAYOUT_V4_FIRST 400      // v0.4.0
+#define LEGACY_LAYOUT_V4_HOSTNAME 403   // v0.4.3: WiFi hostname added
+#define LEGACY_LAYOUT_V4_LAST 499
+
+struct LegacyController {
+    int32_t softwareVersion;    // long on the ESP32
+    uint8_t isDirty;
+    uint8_t reserved[3];
+    int64_t padding;
+};
+
+// Servo record v1: v0.4.x, speed was a 0-3 preset index
+struct LegacyServoV4 {
+    uint8_t pin;
+    uint8_t reserved;
+    uint16_t address;
+    uint8_t swing;
+    int8_t offset;
+    uint8_t speed;
+    uint8_t invert;
+    uint8_t continuous;
+    uint8_t state;
+    uint8_t position;
+    uint8_t reserved2;
+    uint32_t driver;            // Servo pointer
+};
+
+// IPAddress on the ESP32: vtable pointer, then the address
+struct LegacyIPAddress {
+    uint32_t vtable;
+    uint8_t bytes[4];
+};
+
+// WiFi record v1: v0.4.0 - v0.4.2
+struct LegacyWiFiV1 {
+    uint8_t enabled;
+    uint8_t reserved[3];
+    int32_t mode;
+    char stationSSID[WIFI_SSID_MAX_LENGTH];
+    char stationPassword[WIFI_PASSWORD_MAX_LENGTH];
+    char apSSID[WIFI_SSID_MAX_LENGTH];
+    char apPassword[WIFI_PASSWORD_MAX_LENGTH];
+    uint8_t useStaticIP;
+    uint8_t reserved2[3];
+    LegacyIPAddress staticIP;
+    LegacyIPAddress gateway;
+    LegacyIPAddress subnet;
+    LegacyIPAddress dns1;
+    LegacyIPAddress dns2;
+};
+
+// WiFi record v2: v0.4.3
+struct LegacyWiFiV2 {
+    uint8_t enabled;
+    uint8_t reserved[3];
+    int32_t mode;
+    char stationSSID[WIFI_SSID_MAX_LENGTH];
+    char stationPassword[WIFI_PASSWORD_MAX_LENGTH];
+    char apSSID[WIFI_SSID_MAX_LENGTH];
+    char apPassword[WIFI_PASSWORD_MAX_LENGTH];
+    char hostname[WIFI_HOSTNAME_MAX_LENGTH];
+    uint8_t useStaticIP;
+    uint8_t reserved2[3];
+    LegacyIPAddress staticIP;
+    LegacyIPAddress gateway;
+    LegacyIPAddress subnet;
+    LegacyIPAddress dns1;
+    LegacyIPAddress dns2;
+};
+
+#define LEGACY_SERVOS_ADDRESS (sizeof(LegacyController))
+#define LEGACY_WIFI_ADDRESS (LEGACY_SERVOS_ADDRESS + sizeof(LegacyServoV4) * TOTAL_PINS)
+
+static_assert(sizeof(LegacyController) == 16, "v0.4 controller was 16 bytes");
+static_assert(sizeof(LegacyServoV4) == 16, "v0.4 servo entries were 16 bytes");
+static_assert(sizeof(LegacyWiFiV1) == 244 && sizeof(LegacyWiFiV2) == 276, "Released WiFi config sizes");
+
+#endif // SETTINGS_LAYOUTS_H
@@ -0,0 +1,260 @@
+#include "config_journal.h"
+#include "crc32.h"
+
+#define CONFIG_JOURNAL_READ_CHUNK 64
+#define CONFIG_JOURNAL_RUN_GAP 4    // Unchanged bytes worth rewriting to save a run header
+
+// Global instance
+ConfigJournal configJournal;
+
+static uint32_t recordSize(uint32_t length) {
+    return sizeof(ConfigJournalRecordHeader) + ((length + 3) & ~3UL) + sizeof(uint32_t);
+}
+
+ConfigJournal::ConfigJournal()
+    : partition(nullptr)
+    , imageSize(0)
+    , sectorCount(0)
+    , liveSector(0)
+    , maxSequence(0)
+    , appendOffset(0)
+    , ready(false)
+    , eraseCount(0)
+    , appendCount(0)
+    , bytesAppended(0)
+    , compactCount(0) {
+    memset(shadow, 0, sizeof(shadow));
+    memset(sectorErases, 0, sizeof(sectorErases));
+}
+
+bool ConfigJournal::begin(const char *label, uint8_t *image, size_t size) {
+    ready = false;
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (partition == nullptr || size > sizeof(shadow)) {
+        return false;
+    }
+
+    sectorCount = partition->size / CONFIG_JOURNAL_SECTOR_SIZE;
+    if (sectorCount > CONFIG_JOURNAL_MAX_SECTORS) sectorCount = CONFIG_JOURNAL_MAX_SECTORS;
+    if (sectorCount < 2) {
+        return false;
+    }
+    imageSize = size;
+
+    // The live sector is the newest one holding a complete snapshot
+    bool found = false;
+    uint32_t liveSequence = 0;
+    maxSequence = 0;
+    for (uint8_t i = 0; i < sectorCount; i++) {
+        ConfigJournalSectorHeader header;
+        esp_partition_read(partition, sectorAddress(i), &header, sizeof(header));
+        sectorErases[i] = 0;
+        if (header.magic != CONFIG_JOURNAL_MAGIC) continue;
+
+        sectorErases[i] = header.eraseCount;
+        if (header.state != 0) continue;  // Torn before its snapshot was done, even the header may be partial
+
+        if (header.sequence > maxSequence) maxSequence = header.sequence;
+        if (!found || header.sequence > liveSequence) {
+            found = true;
+            liveSector = i;
+            liveSequence = header.sequence;
+        }
+    }
+
+    if (!found) {
+        // Empty journal: the image as loaded becomes the first snapshot
+        liveSector = sectorCount - 1;  // compact() starts the next one, sector 0
+        ready = compact(image);
+        if (ready) {
+            memcpy(shadow, image, imageSize);
+        }
+        return ready;
+    }
+
+    uint32_t offset = sizeof(ConfigJournalSectorHeader);
+    bool torn = false;
+    uint32_t length;
+    while ((length = replayRecord(offset, image, torn)) > 0) {
+        offset += length;
+    }
+
+    // Nothing may follow a torn record: the next append starts a new sector
+    appendOffset = torn ? CONFIG_JOURNAL_SECTOR_SIZE : offset;
+    memcpy(shadow, image, imageSize);
+    ready = true;
+    return true;
+}
+
+uint32_t ConfigJournal::replayRecord(uint32_t offset, uint8_t *image, bool &torn) {
+    uint32_t base = sectorAddress(liveSector);
+    ConfigJournalRecordHeader header;
+
+    if (offset + sizeof(header) > CONFIG_JOURNAL_SECTOR_SIZE) {
+        return 0;
+    }
+    esp_partition_read(partition, base + offset, &header, sizeof(header));
+    if (header.magic == 0xFFFF && header.length == 0xFFFF) {
+        return 0;  // Erased: end of the log
+    }
+
+    uint32_t size = recordSize(header.length);
+    if (header.magic != CONFIG_JOURNAL_RECORD_MAGIC || offset + size > CONFIG_JOURNAL_SECTOR_SIZE) {
+        torn = true;
+        return 0;
+    }
+
+    // Check the whole record before applying any of it
+    uint8_t chunk[CONFIG_JOURNAL_READ_CHUNK];
+    uint32_t crc = crc32(&header, sizeof(header));
+    uint32_t position = offset + sizeof(header);
+    for (uint32_t remaining = header.length; remaining > 0;) {
+        uint32_t n = remaining < sizeof(chunk) ? remaining : sizeof(chunk);
+        esp_partition_read(partition, base + position, chunk, n);
+        crc = crc32(chunk, n, crc);
+        position += n;
+        remaining -= n;
+    }
+    uint32_t storedCrc;
+    esp_partition_read(partition, base + offset + size - sizeof(storedCrc), &storedCrc, sizeof(storedCrc));
+    if (crc != storedCrc) {
+        torn = true;
+        return 0;
+    }
+
+    position = offset + sizeof(header);
+    uint32_t end = position + header.length;
+    while (position < end) {
+        ConfigJournalRun run;
+        esp_partition_read(partition, base + position, &run, sizeof(run));
+        position += sizeof(run);
+        if (position + run.length > end || run.offset + run.length > imageSize) {
+            torn = true;  // Written by a different layout; keep what came before
+            return 0;
+        }
+        esp_partition_read(partition, base + position, image + run.offset, run.length);
+        position += run.length;
+    }
+    return size;
+}
+
+uint32_t ConfigJournal::writeRecord(uint32_t offset, const uint8_t *image, const ConfigJournalRun *runs, uint8_t runCount) {
+    uint32_t base = sectorAddress(liveSector);
+
+    ConfigJournalRecordHeader header = {CONFIG_JOURNAL_RECORD_MAGIC, 0};
+    for (uint8_t i = 0; i < runCount; i++) {
+        header.length += sizeof(ConfigJournalRun) + runs[i].length;
+    }
+
+    uint32_t crc = crc32(&header, sizeof(header));
+    bool ok = (esp_partition_write(partition, base + offset, &header, sizeof(header)) == ESP_OK);
+    uint32_t position = offset + sizeof(header);
+    for (uint8_t i = 0; ok && i < runCount; i++) {
+        crc = crc32(&runs[i], sizeof(ConfigJournalRun), crc);
+        crc = crc32(image + runs[i].offset, runs[i].length, crc);
+        ok = (esp_partition_write(partition, base + position, &runs[i], sizeof(ConfigJournalRun)) == ESP_OK) &&
+             (esp_partition_write(partition, base + position + sizeof(ConfigJournalRun), image + runs[i].offset, runs[i].length) == ESP_OK);
+        position += sizeof(ConfigJournalRun) + runs[i].length;
+    }
+
+    // The CRC goes last: until it is there, the record does not count
+    uint32_t size = recordSize(header.length);
+    ok = ok && (esp_partition_write(partition, base + offset + size - sizeof(crc), &crc, sizeof(crc)) == ESP_OK);
+    return ok ? size : 0;
+}
+
+bool ConfigJournal::compact(const uint8_t *image) {
+    uint8_t sector = (liveSector + 1) % sectorCount;
+    uint32_t base = sectorAddress(sector);
+
+    if (esp_partition_erase_range(partition, base, CONFIG_JOURNAL_SECTOR_SIZE) != ESP_OK) {
+        return false;
+    }
+    sectorErases[sector]++;
+    eraseCount++;
+
+    ConfigJournalSectorHeader header = {CONFIG_JOURNAL_MAGIC, maxSequence + 1, sectorErases[sector], 0xFFFFFFFF};
+    if (esp_partition_write(partition, base, &header, sizeof(header)) != ESP_OK) {
+        return false;
+    }
+    maxSequence = header.sequence;
+
+    // Snapshot, then mark the sector live. Until then boot uses the old one.
+    uint8_t previousSector = liveSector;
+    liveSector = sector;
+    ConfigJournalRun snapshot = {0, (uint16_t)imageSize};
+    uint32_t size = writeRecord(sizeof(header), image, &snapshot, 1);
+    uint32_t live = 0;
+    if (size == 0 || esp_partition_write(partition, base + offsetof(ConfigJournalSectorHeader, state), &live, sizeof(live)) != ESP_OK) {
+        liveSector = previousSector;
+        return false;
+    }
+
+    appendOffset = sizeof(header) + size;
+    compactCount++;
+    return true;
+}
+
+bool ConfigJournal::append(const uint8_t *image) {
+    if (!ready) return false;
+
+    // Runs of changed bytes, merged across short unchanged gaps
+    ConfigJournalRun runs[CONFIG_JOURNAL_MAX_RUNS];
+    uint8_t runCount = 0;
+    bool tooMany = false;
+    uint32_t payload = 0;
+
+    for (size_t i = 0; i < imageSize; i++) {
+        if (image[i] == shadow[i]) continue;
+
+        if (runCount > 0 && i - (runs[runCount - 1].offset + runs[runCount - 1].length) <= CONFIG_JOURNAL_RUN_GAP) {
+            runs[runCount - 1].length = i + 1 - runs[runCount - 1].offset;
+        } else if (runCount < CONFIG_JOURNAL_MAX_RUNS) {
+            runs[runCount++] = {(uint16_t)i, 1};
+        } else {
+            tooMany = true;
+            break;
+        }
+    }
+    if (runCount == 0) {
+        return true;
+    }
+    for (uint8_t i = 0; i < runCount; i++) {
+        payload += sizeof(ConfigJournalRun) + runs[i].length;
+    }
+
+    uint32_t size;
+    if (tooMany || appendOffset + recordSize(payload) > CONFIG_JOURNAL_SECTOR_SIZE) {
+        // Live sector full: carry the whole image over to the next one
+        if (!compact(image)) return false;
+        size = appendOffset;
+    } else {
+        size = writeRecord(appendOffset, image, runs, runCount);
+        if (size == 0) {
+            appendOffset = CONFIG_JOURNAL_SECTOR_SIZE;  // Part written: carry on in a new sector
+            return false;
+        }
+        appendOffset += size;
+    }
+
+    memcpy(shadow, image, imageSize);
+    appendCount++;
+    bytesAppended += size;
+    return true;
+}
+
+uint32_t ConfigJournal::getLifetimeErases() const {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < sectorCount; i++) {
+        total += sectorErases[i];
+    }
+    return total;
+}
+
+uint32_t ConfigJournal::getMaxSectorErases() const {
+    uint32_t most = 0;
+    for (uint8_t i = 0; i < sectorCount; i++) {
+        if (sectorErases[i] > most) most = sectorErases[i];
+    }
+    return most;
+}
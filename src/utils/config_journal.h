@@ -0,0 +1,147 @@
+#ifndef CONFIG_JOURNAL_H
+#define CONFIG_JOURNAL_H
+
+#include <Arduino.h>
+#include <esp_partition.h>
+#include "../config.h"
+
+#define CONFIG_JOURNAL_SECTOR_SIZE 4096
+#define CONFIG_JOURNAL_MAX_SECTORS 16
+#define CONFIG_JOURNAL_MAX_RUNS 16      // Changed runs in one delta record; more and a snapshot is written instead
+#define CONFIG_JOURNAL_MAGIC 0x4C4E4A43 // "CJNL"
+#define CONFIG_JOURNAL_RECORD_MAGIC 0x524A  // "JR"
+
+// First bytes of every journal sector
+struct ConfigJournalSectorHeader {
+    uint32_t magic;         // CONFIG_JOURNAL_MAGIC once the sector has been started
+    uint32_t sequence;      // Higher = newer
+    uint32_t eraseCount;    // Times this sector has been erased
+    uint32_t state;         // 0xFFFFFFFF while being filled, 0 once it holds a full snapshot
+};
+
+// Journal record: header, runs of {offset, length, bytes}, padding to 4 bytes, CRC-32 of header and runs
+struct ConfigJournalRecordHeader {
+    uint16_t magic;         // CONFIG_JOURNAL_RECORD_MAGIC
+    uint16_t length;        // Bytes of runs that follow
+};
+
+// One run of changed bytes in a record
+struct ConfigJournalRun {
+    uint16_t offset;        // Position in the image
+    uint16_t length;
+};
+
+/**
+ * @brief Append-only journal of the settings image in a flash partition
+ *
+ * Replaces whole-sector rewrites of the emulated EEPROM. The partition is a
+ * ring of 4 KB sectors, one of them live. A live sector starts with a
+ * snapshot of the whole image, followed by delta records: the runs of bytes
+ * that changed since the previous record, with a CRC-32. Saving a one-byte
+ * change appends about 20 bytes; a sector is only erased when the live one is
+ * full, and then it is the next one in the ring, so wear is spread evenly.
+ *
+ * Power loss is safe at any point:
+ * - A torn record fails its CRC; replay stops before it (the save is lost,
+ *   earlier ones are kept) and the next save starts a fresh sector
+ * - A new sector only becomes live (state word cleared) once its snapshot is
+ *   complete; until then boot keeps using the previous sector, which is not
+ *   touched until the ring comes round to it again
+ */
+class ConfigJournal {
+private:
+    const esp_partition_t *partition;
+    uint8_t shadow[EEPROM_SIZE];  // Image as the journal holds it
+    size_t imageSize;
+    uint8_t sectorCount;
+    uint8_t liveSector;
+    uint32_t maxSequence;       // Highest sequence number of a live sector
+    uint32_t appendOffset;      // Next record position in the live sector
+    bool ready;
+
+    // Statistics
+    uint32_t sectorErases[CONFIG_JOURNAL_MAX_SECTORS];  // Lifetime, from the sector headers
+    uint32_t eraseCount;        // This boot
+    uint32_t appendCount;
+    uint32_t bytesAppended;
+    uint32_t compactCount;
+
+    /**
+     * @brief Check a record and apply it to the image if its CRC matches
+     * @return Record size in flash, or 0 at the end of the log or a bad record
+     */
+    uint32_t replayRecord(uint32_t offset, uint8_t *image, bool &torn);
+
+    /**
+     * @brief Write a record of runs from the image, its CRC last
+     * @param offset Record position in the live sector
+     * @return Record size in flash, or 0 on a flash error
+     */
+    uint32_t writeRecord(uint32_t offset, const uint8_t *image, const ConfigJournalRun *runs, uint8_t runCount);
+
+    /**
+     * @brief Start the next sector in the ring with a snapshot of the image
+     */
+    bool compact(const uint8_t *image);
+
+    uint32_t sectorAddress(uint8_t sector) const { return (uint32_t)sector * CONFIG_JOURNAL_SECTOR_SIZE; }
+
+public:
+    /**
+     * @brief Construct a journal (not attached to flash)
+     */
+    ConfigJournal();
+
+    ConfigJournal(const ConfigJournal &) = delete;
+    ConfigJournal &operator=(const ConfigJournal &) = delete;
+
+    /**
+     * @brief Find the partition and load the image from the live sector
+     *
+     * If the journal is empty, the image is left as it is and written as the
+     * first snapshot, which moves existing settings into the journal.
+     * @param label Partition label
+     * @param image Settings image, replaced by the journal's copy
+     * @param size Image size (at most EEPROM_SIZE)
+     * @return false if there is no such partition (the journal is not used)
+     */
+    bool begin(const char *label, uint8_t *image, size_t size);
+
+    /**
+     * @brief Append the bytes that changed since the last append
+     * @param image Settings image
+     * @return true if the journal holds the image
+     */
+    bool append(const uint8_t *image);
+
+    /**
+     * @brief Check if the journal is in use
+     * @return true after a successful begin()
+     */
+    bool isReady() const { return ready; }
+
+    uint8_t getSectorCount() const { return sectorCount; }
+    uint8_t getLiveSector() const { return liveSector; }
+    uint32_t getUsedBytes() const { return appendOffset; }
+    uint32_t getEraseCount() const { return eraseCount; }
+    uint32_t getAppendCount() const { return appendCount; }
+    uint32_t getBytesAppended() const { return bytesAppended; }
+    uint32_t getCompactCount() const { return compactCount; }
+
+    /**
+     * @brief Get erases over the life of the flash
+     * @return Sum over all sectors
+     */
+    uint32_t getLifetimeErases() const;
+
+    /**
+     * @brief Get the erases of the most worn sector
+     * @return Highest per-sector count
+     */
+    uint32_t getMaxSectorErases() const;
+};
+
+// Global instance
+extern ConfigJournal configJournal;
+
+#endif // CONFIG_JOURNAL_H
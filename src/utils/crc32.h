@@ -0,0 +1,15 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <Arduino.h>
+
+/**
+ * @brief CRC-32 (IEEE 802.3, as zlib)
+ * @param data Bytes to checksum
+ * @param length Number of bytes
+ * @param crc CRC of the bytes before these, to checksum data in pieces
+ * @return CRC of everything so far
+ */
+uint32_t crc32(const void *data, size_t length, uint32_t crc = 0);
+
+#endif // CRC32_H
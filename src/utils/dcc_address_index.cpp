@@ -0,0 +1,76 @@
+#include "dcc_address_index.h"
+
+// Global instance
+DccAddressIndex dccAddressIndex;
+
+DccAddressIndex::DccAddressIndex()
+    : addressCount(0)
+    , blockFirstAddress(1)
+    , blockPacketBoard(1) {
+    memset(ownedBits, 0, sizeof(ownedBits));
+    memset(rankBase, 0, sizeof(rankBase));
+    memset(servoMask, 0, sizeof(servoMask));
+    memset(blockMask, 0, sizeof(blockMask));
+    memset(servoAddress, 0, sizeof(servoAddress));
+}
+
+bool DccAddressIndex::isValid(const DccAddressing &settings) {
+    return settings.mode <= DCC_ADDRESS_MODE_BOARD &&
+           (settings.shift == DCC_ADDRESS_SHIFT_NONE || settings.shift == DCC_ADDRESS_SHIFT_BOARD) &&
+           settings.boardBase >= 1 && settings.boardBase <= DCC_MAX_BOARD_BASE;
+}
+
+bool DccAddressIndex::configure(const DccAddressing &settings) {
+    bool valid = isValid(settings);
+    addressing = valid ? settings : DccAddressing();
+
+    // Both in the station's numbering: a +4 shift moves the block one board down the wire
+    blockFirstAddress = (addressing.boardBase - 1) * DCC_BOARD_OUTPUTS + 1;
+    blockPacketBoard = addressing.boardBase - addressing.shift / DCC_BOARD_OUTPUTS;
+    return valid;
+}
+
+const char *DccAddressIndex::getShiftName(uint8_t shift) {
+    return (shift == DCC_ADDRESS_SHIFT_BOARD) ? "+4" : "none";
+}
+
+void DccAddressIndex::rebuild(const uint16_t *addresses, uint8_t count) {
+    if (count > TOTAL_PINS) count = TOTAL_PINS;
+    
+    memset(ownedBits, 0, sizeof(ownedBits));
+    memset(servoMask, 0, sizeof(servoMask));
+    memset(blockMask, 0, sizeof(blockMask));
+    memset(servoAddress, 0, sizeof(servoAddress));
+    
+    // Board mode: servo n is output n of the block, whatever its own address
+    for (uint8_t i = 0; i < count; i++) {
+        blockMask[i] = 1U << i;
+        servoAddress[i] = (addressing.mode == DCC_ADDRESS_MODE_BOARD) ? blockFirstAddress + i
+                        : (addresses[i] <= DCC_MAX_ADDRESS) ? addresses[i] : 0;
+    }
+    
+    // Pass 1: mark owned addresses (0 means unassigned)
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t address = addresses[i];
+        if (address == 0 || address > DCC_MAX_ADDRESS) continue;
+        ownedBits[address >> 5] |= 1UL << (address & 31);
+    }
+    
+    // Pass 2: prefix counts so an address resolves to its rank in the bitset
+    uint8_t rank = 0;
+    for (uint8_t w = 0; w < DCC_ADDRESS_INDEX_WORDS; w++) {
+        rankBase[w] = rank;
+        rank += __builtin_popcount(ownedBits[w]);
+    }
+    addressCount = rank;
+    
+    // Pass 3: fold every servo into the mask of its address slot
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t address = addresses[i];
+        if (address == 0 || address > DCC_MAX_ADDRESS) continue;
+        
+        uint32_t word = ownedBits[address >> 5];
+        uint32_t bit = 1UL << (address & 31);
+        servoMask[rankBase[address >> 5] + __builtin_popcount(word & (bit - 1))] |= (1U << i);
+    }
+}
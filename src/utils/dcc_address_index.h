@@ -0,0 +1,184 @@
+#ifndef DCC_ADDRESS_INDEX_H
+#define DCC_ADDRESS_INDEX_H
+
+#include <Arduino.h>
+#include "../config.h"
+
+#define DCC_MAX_ADDRESS 2048
+#define DCC_ADDRESS_INDEX_WORDS ((DCC_MAX_ADDRESS + 1 + 31) / 32)
+#define DCC_BOARD_OUTPUTS 4                               // Output pairs per board address
+#define DCC_BLOCK_BOARDS (TOTAL_PINS / DCC_BOARD_OUTPUTS)  // Boards claimed in board mode
+#define DCC_MAX_BOARD_BASE ((DCC_MAX_ADDRESS - TOTAL_PINS) / DCC_BOARD_OUTPUTS + 1)
+
+static_assert(TOTAL_PINS % DCC_BOARD_OUTPUTS == 0, "Board mode claims whole boards");
+
+// How servos get their DCC addresses
+enum DccAddressMode : uint8_t {
+    DCC_ADDRESS_MODE_OUTPUT = 0,    // Each servo listens on its own output address
+    DCC_ADDRESS_MODE_BOARD = 1      // Servo n is output n of a block of boards from boardBase
+};
+
+// Output addresses a command station numbers ahead of the packet it sends
+#define DCC_ADDRESS_SHIFT_NONE 0    // RCN-213: board 1 output 1 is address 1
+#define DCC_ADDRESS_SHIFT_BOARD 4   // Board 0 output 1 is address 1 (Roco, Fleischmann and others)
+
+/**
+ * @brief Addressing settings; stored as the DCC record (settings_layouts.h)
+ *
+ * Addresses and board numbers are as the command station shows them.
+ */
+struct DccAddressing {
+    uint8_t mode = DCC_ADDRESS_MODE_OUTPUT;  // DccAddressMode
+    uint8_t shift = DCC_ADDRESS_SHIFT_NONE;  // DCC_ADDRESS_SHIFT_NONE or DCC_ADDRESS_SHIFT_BOARD
+    uint16_t boardBase = 1;                   // First board of the block (board mode), 1-DCC_MAX_BOARD_BASE
+};
+
+/**
+ * @brief Precomputed DCC address to servo lookup
+ * 
+ * Holds a bitset of every accessory address owned by a servo, plus a compact
+ * table of servo bitmasks (one entry per owned address). The table position of
+ * an address is its rank in the bitset, so a lookup is one word test and one
+ * popcount. Foreign addresses are rejected by the bit test alone.
+ * 
+ * In board mode the servos instead take consecutive outputs of
+ * DCC_BLOCK_BOARDS boards, and a packet resolves by subtracting the first
+ * board (or address) of the block and checking the result against the block
+ * size; a small table then translates the output to its servos.
+ *
+ * Addresses passed in are as the command station numbers them; packets are
+ * numbered per RCN-213, so a station with a shift needs toStationAddress().
+ * 
+ * The index is only rebuilt when the servo configuration changes.
+ */
+class DccAddressIndex {
+private:
+    uint32_t ownedBits[DCC_ADDRESS_INDEX_WORDS];
+    uint8_t rankBase[DCC_ADDRESS_INDEX_WORDS];   // Owned addresses in all preceding words
+    uint16_t servoMask[TOTAL_PINS];              // Servo bitmask, ordered by address
+    uint8_t addressCount;
+
+    // Board mode
+    DccAddressing addressing;
+    uint16_t blockMask[TOTAL_PINS];              // Servo bitmask per output of the block
+    uint16_t blockFirstAddress;                  // Station address of the first output
+    uint16_t blockPacketBoard;                   // First board as packets number it
+    uint16_t servoAddress[TOTAL_PINS];           // Station address each servo answers to
+
+public:
+    /**
+     * @brief Construct an empty index
+     */
+    DccAddressIndex();
+
+    /**
+     * @brief Rebuild the index from a list of servo addresses
+     * @param addresses DCC address per servo slot (0 = unassigned)
+     * @param count Number of servo slots (at most TOTAL_PINS)
+     */
+    void rebuild(const uint16_t *addresses, uint8_t count);
+
+    /**
+     * @brief Set the addressing mode (takes effect at the next rebuild())
+     * @param settings Mode, shift and block; defaults are used if invalid
+     * @return false if the settings were invalid
+     */
+    bool configure(const DccAddressing &settings);
+
+    /**
+     * @brief Check addressing settings before they are applied
+     */
+    static bool isValid(const DccAddressing &settings);
+
+    /**
+     * @brief Look up the servos listening on an address
+     * @param address DCC accessory address, as the command station numbers it
+     * @return Bitmask of servo slots (bit n = virtualservo[n]), 0 if not ours
+     */
+    uint16_t lookup(uint16_t address) const {
+        if (addressing.mode == DCC_ADDRESS_MODE_BOARD) {
+            uint16_t output = address - blockFirstAddress;
+            return (output < TOTAL_PINS) ? blockMask[output] : 0;
+        }
+        if (address > DCC_MAX_ADDRESS) return 0;
+        
+        uint32_t word = ownedBits[address >> 5];
+        uint32_t bit = 1UL << (address & 31);
+        if ((word & bit) == 0) return 0;
+        
+        return servoMask[rankBase[address >> 5] + __builtin_popcount(word & (bit - 1))];
+    }
+
+    /**
+     * @brief Look up the servos on a board output (board mode)
+     * @param board Board address from the packet (NmraDcc's notifyDccAccTurnoutBoard)
+     * @param pair Output pair, 0-3
+     * @return Bitmask of servo slots, 0 if not ours or not in board mode
+     */
+    uint16_t lookupBoard(uint16_t board, uint8_t pair) const {
+        uint16_t block = board - blockPacketBoard;
+        if (block >= DCC_BLOCK_BOARDS || addressing.mode != DCC_ADDRESS_MODE_BOARD) return 0;
+        return blockMask[block * DCC_BOARD_OUTPUTS + pair];
+    }
+
+    /**
+     * @brief Output address of a packet as the command station numbers it
+     * @param packetAddress Address NmraDcc decoded (notifyDccAccTurnoutOutput)
+     */
+    uint16_t toStationAddress(uint16_t packetAddress) const { return packetAddress + addressing.shift; }
+
+    /**
+     * @brief Output address of a board output as the command station numbers it
+     * @param board Board address from the packet
+     * @param pair Output pair, 0-3
+     */
+    uint16_t toStationAddress(uint16_t board, uint8_t pair) const {
+        return (board - 1) * DCC_BOARD_OUTPUTS + pair + 1 + addressing.shift;
+    }
+
+    /**
+     * @brief Check if any servo listens on an address
+     * @param address DCC accessory address, as the command station numbers it
+     * @return true if the address is ours
+     */
+    bool owns(uint16_t address) const {
+        if (addressing.mode == DCC_ADDRESS_MODE_BOARD) {
+            return (uint16_t)(address - blockFirstAddress) < TOTAL_PINS;
+        }
+        return (address <= DCC_MAX_ADDRESS) && (ownedBits[address >> 5] & (1UL << (address & 31)));
+    }
+
+    /**
+     * @brief Address a servo answers to in the current mode (0 = none)
+     * @param servo Servo slot
+     */
+    uint16_t getServoAddress(uint8_t servo) const { return servo < TOTAL_PINS ? servoAddress[servo] : 0; }
+
+    /**
+     * @brief Get the addressing settings in use
+     */
+    const DccAddressing &getAddressing() const { return addressing; }
+
+    bool isBoardMode() const { return addressing.mode == DCC_ADDRESS_MODE_BOARD; }
+
+    /**
+     * @brief Station address of the first output of the block (board mode)
+     */
+    uint16_t getBlockFirstAddress() const { return blockFirstAddress; }
+
+    /**
+     * @brief Name of a shift ("none" or "+4")
+     */
+    static const char *getShiftName(uint8_t shift);
+
+    /**
+     * @brief Get the number of distinct addresses in the index
+     * @return Distinct owned addresses
+     */
+    uint8_t getAddressCount() const { return addressing.mode == DCC_ADDRESS_MODE_BOARD ? TOTAL_PINS : addressCount; }
+};
+
+// Global instance
+extern DccAddressIndex dccAddressIndex;
+
+#endif // DCC_ADDRESS_INDEX_H
@@ -0,0 +1,157 @@
+#include "dcc_capture.h"
+#include <LittleFS.h>
+#include <EEPROM.h>
+#include "page_writer.h"
+#include "diag_log.h"
+
+static_assert((DCC_CAPTURE_SIZE & (DCC_CAPTURE_SIZE - 1)) == 0, "DCC_CAPTURE_SIZE must be a power of two");
+static_assert(DCC_CAPTURE_SPILL_BATCH <= DCC_CAPTURE_SIZE / 2, "Spill batches must leave room for new packets");
+static_assert(sizeof(DccCaptureHeader) == 24 && sizeof(DccCaptureRecord) == 12, "Capture file layout");
+
+#define DCC_CAPTURE_READ_CHUNK 256  // Spill file bytes read per chunk of the download
+
+// Global instance
+DccCapture dccCapture;
+
+DccCapture::DccCapture()
+    : nextSequence(0)
+    , firstSequence(0)
+    , fileRecords(0)
+    , enabled(false)
+    , spilling(false)
+    , lostCount(0)
+    , idleCount(0) {
+}
+
+bool DccCapture::start(bool toFile) {
+    stop();
+    nextSequence = 0;
+    firstSequence = 0;
+    fileRecords = 0;
+    lostCount = 0;
+    idleCount = 0;
+
+    if (toFile) {
+        // The spiffs partition is otherwise unused: format it on first use
+        if (!LittleFS.begin(true)) {
+            DIAG_ERROR("DCC capture: LittleFS not available");
+            return false;
+        }
+        file = LittleFS.open(DCC_CAPTURE_FILE, "w");
+        if (!file) {
+            DIAG_ERROR("DCC capture: cannot create %s", DCC_CAPTURE_FILE);
+            return false;
+        }
+        spilling = true;
+    }
+
+    enabled = true;
+    return true;
+}
+
+void DccCapture::stop() {
+    if (spilling) {
+        spill(getHeldCount());
+        file.close();
+        spilling = false;
+    }
+    enabled = false;
+}
+
+void DccCapture::record(const uint8_t *data, uint8_t size) {
+    if (!enabled) return;
+
+    // Idle packets are most of the traffic and never change anything
+    if (size == 3 && data[0] == 0xFF && data[1] == 0x00) {
+        idleCount++;
+        return;
+    }
+
+    if (nextSequence - firstSequence == DCC_CAPTURE_SIZE) {
+        if (spilling) {
+            lostCount++;  // Unsaved packets are kept; the gap is counted
+            return;
+        }
+        firstSequence++;
+    }
+
+    DccCaptureRecord &entry = records[nextSequence & (DCC_CAPTURE_SIZE - 1)];
+    entry.timestampUs = micros();
+    entry.size = size > DCC_CAPTURE_PACKET_MAX ? DCC_CAPTURE_PACKET_MAX : size;
+    memcpy(entry.data, data, entry.size);
+    memset(entry.data + entry.size, 0, DCC_CAPTURE_PACKET_MAX - entry.size);
+    entry.reserved = 0;
+    nextSequence++;
+}
+
+bool DccCapture::spill(uint32_t count) {
+    uint32_t room = (DCC_CAPTURE_FILE_MAX / sizeof(DccCaptureRecord)) - fileRecords;
+    bool full = (count > room);
+    if (full) count = room;
+
+    while (count > 0) {
+        // Up to the end of the ring in one write
+        uint32_t index = firstSequence & (DCC_CAPTURE_SIZE - 1);
+        uint32_t n = DCC_CAPTURE_SIZE - index;
+        if (n > count) n = count;
+        size_t bytes = n * sizeof(DccCaptureRecord);
+        if (file.write((const uint8_t *)&records[index], bytes) != bytes) {
+            DIAG_ERROR("DCC capture: write to %s failed, capture stopped", DCC_CAPTURE_FILE);
+            enabled = false;
+            return false;
+        }
+        firstSequence += n;
+        fileRecords += n;
+        count -= n;
+    }
+
+    if (full && enabled) {
+        DIAG_WARN("DCC capture: %s full, capture stopped", DCC_CAPTURE_FILE);
+        enabled = false;
+    }
+    return true;
+}
+
+void DccCapture::update() {
+    if (!spilling) return;
+
+    if (enabled && getHeldCount() >= DCC_CAPTURE_SPILL_BATCH) {
+        spill(DCC_CAPTURE_SPILL_BATCH);
+    }
+    if (!enabled) {
+        // Stopped by a full or failed file; the rest stays in RAM for the download
+        file.close();
+        spilling = false;
+    }
+}
+
+void DccCapture::send(WebServer &server) {
+    if (spilling) file.flush();
+
+    DccCaptureHeader header = {DCC_CAPTURE_MAGIC, DCC_CAPTURE_VERSION, sizeof(DccCaptureRecord), EEPROM_SIZE,
+                               getRecordCount(), lostCount, idleCount};
+
+    PageWriter page(server);
+    server.sendHeader("Content-Disposition", "attachment; filename=\"dcc-capture.bin\"");
+    page.begin(200, "application/octet-stream");
+    page.write(&header, sizeof(header));
+    page.write(EEPROM.getDataPtr(), EEPROM_SIZE);
+
+    if (fileRecords > 0) {
+        fs::File in = LittleFS.open(DCC_CAPTURE_FILE, "r");
+        uint8_t chunk[DCC_CAPTURE_READ_CHUNK];
+        size_t remaining = fileRecords * sizeof(DccCaptureRecord);
+        while (in && remaining > 0) {
+            size_t n = in.read(chunk, remaining < sizeof(chunk) ? remaining : sizeof(chunk));
+            if (n == 0) break;  // Short file: the replayer reports it as truncated
+            page.write(chunk, n);
+            remaining -= n;
+        }
+        in.close();
+    }
+
+    for (uint32_t sequence = firstSequence; sequence != nextSequence; sequence++) {
+        page.write(&records[sequence & (DCC_CAPTURE_SIZE - 1)], sizeof(DccCaptureRecord));
+    }
+    page.end();
+}
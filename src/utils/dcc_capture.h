@@ -0,0 +1,124 @@
+#ifndef DCC_CAPTURE_H
+#define DCC_CAPTURE_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <WebServer.h>
+#include "../config.h"
+
+/*
+ * Capture download format (little-endian, as the ESP32 lays it out):
+ *
+ *   [DccCaptureHeader][settings image, settingsSize bytes][DccCaptureRecord] x recordCount
+ *
+ * The settings image is the EEPROM image at download time, so a replay runs
+ * against the same servo configuration. Records are in the order the packets
+ * were decoded; timestamps are micros() and wrap after 71 minutes, so only
+ * differences between neighbouring records mean anything.
+ */
+
+#define DCC_CAPTURE_MAGIC 0x50414344UL  // "DCAP"
+#define DCC_CAPTURE_VERSION 1
+#define DCC_CAPTURE_PACKET_MAX 6        // Longest packet NmraDcc decodes (MAX_DCC_MESSAGE_LEN)
+
+struct DccCaptureHeader {
+    uint32_t magic;         // DCC_CAPTURE_MAGIC
+    uint16_t version;       // DCC_CAPTURE_VERSION
+    uint16_t recordSize;    // sizeof(DccCaptureRecord)
+    uint32_t settingsSize;  // Bytes of settings image after the header
+    uint32_t recordCount;   // Records after the settings image
+    uint32_t lost;          // Packets dropped while spilling (ring full waiting for flash)
+    uint32_t idle;          // Idle packets seen and not recorded
+};
+
+struct DccCaptureRecord {
+    uint32_t timestampUs;   // micros() when the packet was decoded
+    uint8_t size;           // Packet bytes, error detection byte included
+    uint8_t data[DCC_CAPTURE_PACKET_MAX];
+    uint8_t reserved;
+};
+
+/**
+ * @brief Raw DCC packet capture for replaying a session offline
+ *
+ * Every packet NmraDcc decodes (notifyDccMsg) is recorded with a microsecond
+ * timestamp in a ring of DCC_CAPTURE_SIZE records; idle packets are only
+ * counted. In RAM the ring keeps the most recent packets. With spilling on,
+ * update() appends the ring to DCC_CAPTURE_FILE on LittleFS a batch at a
+ * time, so a capture can cover a whole session; if the flash falls behind,
+ * new packets are dropped and counted rather than overwriting unsaved ones.
+ *
+ * Recording, spilling and the download all run from loop(), so nothing is
+ * shared with another task.
+ */
+class DccCapture {
+private:
+    DccCaptureRecord records[DCC_CAPTURE_SIZE];
+    uint32_t nextSequence;      // Sequence number the next packet gets
+    uint32_t firstSequence;     // Oldest packet still in the ring
+    uint32_t fileRecords;       // Packets in the spill file
+    bool enabled;
+    bool spilling;
+    fs::File file;
+
+    // Statistics
+    uint32_t lostCount;
+    uint32_t idleCount;
+
+    /**
+     * @brief Append the oldest packets in the ring to the spill file
+     * @param count Packets to write (at most those in the ring)
+     * @return false on a write error
+     */
+    bool spill(uint32_t count);
+
+public:
+    /**
+     * @brief Construct an empty capture (not recording)
+     */
+    DccCapture();
+
+    /**
+     * @brief Clear the capture and start recording
+     * @param toFile true to spill to DCC_CAPTURE_FILE, false for RAM only
+     * @return false if the file could not be created
+     */
+    bool start(bool toFile);
+
+    /**
+     * @brief Stop recording (the capture is kept for download)
+     */
+    void stop();
+
+    /**
+     * @brief Record a decoded packet (NmraDcc's notifyDccMsg)
+     * @param data Packet bytes
+     * @param size Number of bytes
+     */
+    void record(const uint8_t *data, uint8_t size);
+
+    /**
+     * @brief Spill full batches to the file; call from loop()
+     */
+    void update();
+
+    /**
+     * @brief Send the capture as a download (header, settings image, records)
+     * @param server Web server handling the request
+     */
+    void send(WebServer &server);
+
+    bool isEnabled() const { return enabled; }
+    bool isSpilling() const { return spilling; }
+    uint32_t getPacketCount() const { return nextSequence; }
+    uint32_t getHeldCount() const { return nextSequence - firstSequence; }
+    uint32_t getFileCount() const { return fileRecords; }
+    uint32_t getRecordCount() const { return fileRecords + getHeldCount(); }
+    uint32_t getLostCount() const { return lostCount; }
+    uint32_t getIdleCount() const { return idleCount; }
+};
+
+// Global instance
+extern DccCapture dccCapture;
+
+#endif // DCC_CAPTURE_H
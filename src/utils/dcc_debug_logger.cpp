@@ -1,4 +1,9 @@
 #include "dcc_debug_logger.h"
+#include "diag_log.h"
+
+static_assert(sizeof(DccLogRecord) == 8, "DccLogRecord should stay 8 bytes");
+static_assert((DCC_LOG_SIZE & (DCC_LOG_SIZE - 1)) == 0, "DCC_LOG_SIZE must be a power of two");
+static_assert(DCC_LOG_SIZE <= 32768, "DCC_LOG_SIZE must fit the 16-bit ring counters");
 
 // Global instance
 DccDebugLogger dccDebugLogger;
@@ -6,47 +11,134 @@ DccDebugLogger dccDebugLogger;
 DccDebugLogger::DccDebugLogger()
     : logIndex(0)
     , logCount(0)
+    , nextSequence(0)
+    , echoSequence(0)
     , debugEnabled(false) {
 }
 
-void DccDebugLogger::addMessage(const String& message) {
-    logBuffer[logIndex] = message;
-    logTimestamp[logIndex] = millis();
-    logIndex = (logIndex + 1) % DCC_LOG_SIZE;
+void DccDebugLogger::addRecord(uint16_t address, uint8_t event, uint8_t flags) {
+    DccLogRecord &record = records[logIndex];
+    record.timestamp = millis();
+    record.address = address;
+    record.event = event;
+    record.flags = flags;
+    logIndex = (logIndex + 1) & (DCC_LOG_SIZE - 1);
+    nextSequence++;
     
     if (logCount < DCC_LOG_SIZE) {
         logCount++;
     }
-    
-    // Print to serial if debug is enabled
-    if (debugEnabled) {
-        Serial.println(message);
-    }
+}
+
+void DccDebugLogger::logPacket(uint16_t address, uint8_t direction, uint8_t power, bool match) {
+    uint8_t flags = (direction ? DCC_LOG_DIRECTION : 0) | (power ? DCC_LOG_POWER : 0) | (match ? DCC_LOG_MATCH : 0);
+    addRecord(address, DCC_LOG_PACKET, flags);
+}
+
+void DccDebugLogger::logServoAction(uint8_t pin, uint8_t direction) {
+    addRecord(pin, DCC_LOG_SERVO_ACTION, direction ? DCC_LOG_DIRECTION : 0);
+}
+
+void DccDebugLogger::logAspectPacket(uint16_t address, uint8_t aspect, bool match) {
+    addRecord(address, DCC_LOG_ASPECT_PACKET, (aspect << DCC_LOG_ASPECT_SHIFT) | (match ? DCC_LOG_MATCH : 0));
+}
+
+void DccDebugLogger::logServoAspect(uint8_t pin, uint8_t aspect) {
+    addRecord(pin, DCC_LOG_SERVO_ASPECT, aspect << DCC_LOG_ASPECT_SHIFT);
+}
+
+void DccDebugLogger::logSignal() {
+    addRecord(0, DCC_LOG_SIGNAL, 0);
 }
 
 void DccDebugLogger::toggleDebug() {
-    debugEnabled = !debugEnabled;
+    if (debugEnabled) {
+        disableDebug();
+    } else {
+        enableDebug();
+    }
     Serial.printf("DCC Debug: %s\n", debugEnabled ? "ENABLED" : "DISABLED");
 }
 
-String DccDebugLogger::getLogMessage(int index) const {
+void DccDebugLogger::update() {
+    if (!debugEnabled) return;
+
+    // Records overwritten before they were echoed are only counted
+    uint32_t first = getFirstSequence();
+    if ((int32_t)(echoSequence - first) < 0) {
+        DIAG_WARN("DCC debug: %lu records not echoed", (unsigned long)(first - echoSequence));
+        echoSequence = first;
+    }
+
+    char message[64];
+    DccLogRecord record;
+    while (echoSequence != nextSequence && getRecordBySequence(echoSequence, record)) {
+        formatMessage(record, message, sizeof(message));
+        DIAG_INFO("%s", message);  // Queued for the diag task: loop() never waits on the UART
+        echoSequence++;
+    }
+}
+
+bool DccDebugLogger::getRecord(int index, DccLogRecord &record) const {
     if (index < 0 || index >= logCount) {
-        return "";
+        return false;
     }
     
     // Calculate actual buffer index
-    int bufferIndex = (logIndex - logCount + index + DCC_LOG_SIZE) % DCC_LOG_SIZE;
-    return logBuffer[bufferIndex];
+    record = records[(logIndex - logCount + index) & (DCC_LOG_SIZE - 1)];
+    return true;
+}
+
+size_t DccDebugLogger::formatMessage(const DccLogRecord &record, char *buffer, size_t size) {
+    int len;
+    
+    switch (record.event) {
+        case DCC_LOG_PACKET:
+            len = snprintf(buffer, size, "DCC RX: Addr=%u, Dir=%u, Pwr=%X %s", record.address,
+                           (record.flags & DCC_LOG_DIRECTION) ? 1 : 0, (record.flags & DCC_LOG_POWER) ? 1 : 0,
+                           (record.flags & DCC_LOG_MATCH) ? "[MATCH]" : "[ignore]");
+            break;
+        case DCC_LOG_SERVO_ACTION:
+            len = snprintf(buffer, size, "Servo action: Pin %u -> %s", record.address,
+                           (record.flags & DCC_LOG_DIRECTION) ? "THROWN" : "CLOSED");
+            break;
+        case DCC_LOG_SIGNAL:
+            len = snprintf(buffer, size, "DCC signal triggered");
+            break;
+        case DCC_LOG_ASPECT_PACKET:
+            len = snprintf(buffer, size, "DCC RX: Addr=%u, Aspect=%u %s", record.address,
+                           record.flags >> DCC_LOG_ASPECT_SHIFT, (record.flags & DCC_LOG_MATCH) ? "[MATCH]" : "[ignore]");
+            break;
+        case DCC_LOG_SERVO_ASPECT:
+            len = snprintf(buffer, size, "Servo action: Pin %u -> ASPECT %u", record.address,
+                           record.flags >> DCC_LOG_ASPECT_SHIFT);
+            break;
+        default:
+            len = snprintf(buffer, size, "Unknown event %u", record.event);
+            break;
+    }
+    
+    if (len < 0) return 0;
+    return ((size_t)len < size) ? (size_t)len : size - 1;
+}
+
+String DccDebugLogger::getLogMessage(int index) const {
+    DccLogRecord record;
+    if (!getRecord(index, record)) {
+        return "";
+    }
+    
+    char message[64];
+    formatMessage(record, message, sizeof(message));
+    return String(message);
 }
 
 unsigned long DccDebugLogger::getLogTimestamp(int index) const {
-    if (index < 0 || index >= logCount) {
+    DccLogRecord record;
+    if (!getRecord(index, record)) {
         return 0;
     }
-    
-    // Calculate actual buffer index
-    int bufferIndex = (logIndex - logCount + index + DCC_LOG_SIZE) % DCC_LOG_SIZE;
-    return logTimestamp[bufferIndex];
+    return record.timestamp;
 }
 
 void DccDebugLogger::clearLog() {
@@ -61,17 +153,18 @@ String DccDebugLogger::getFormattedLogHtml() const {
     if (logCount == 0) {
         html += "<p><em>No DCC debug messages logged yet.</em></p>";
     } else {
+        int first = (logCount > DCC_LOG_WEB_ENTRIES) ? logCount - DCC_LOG_WEB_ENTRIES : 0;
+        html.reserve(64 + (logCount - first) * 80);
         html += "<table class='log-table'>";
         html += "<tr><th>Time</th><th>Message</th></tr>";
         
-        for (int i = 0; i < logCount; i++) {
-            unsigned long timestamp = getLogTimestamp(i);
-            String message = getLogMessage(i);
-            
-            html += "<tr>";
-            html += "<td>" + String(timestamp) + "ms</td>";
-            html += "<td>" + message + "</td>";
-            html += "</tr>";
+        char message[64];
+        char row[128];
+        DccLogRecord record;
+        for (int i = first; getRecord(i, record); i++) {
+            formatMessage(record, message, sizeof(message));
+            snprintf(row, sizeof(row), "<tr><td>%lums</td><td>%s</td></tr>", (unsigned long)record.timestamp, message);
+            html += row;
         }
         
         html += "</table>";
@@ -87,10 +180,11 @@ void DccDebugLogger::printLogToSerial() const {
     if (logCount == 0) {
         Serial.println("No messages logged.");
     } else {
-        for (int i = 0; i < logCount; i++) {
-            unsigned long timestamp = getLogTimestamp(i);
-            String message = getLogMessage(i);
-            Serial.printf("[%lu ms] %s\n", timestamp, message.c_str());
+        char message[64];
+        DccLogRecord record;
+        for (int i = 0; getRecord(i, record); i++) {
+            formatMessage(record, message, sizeof(message));
+            Serial.printf("[%lu ms] %s\n", (unsigned long)record.timestamp, message);
         }
     }
     
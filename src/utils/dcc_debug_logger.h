@@ -4,20 +4,59 @@
 #include <Arduino.h>
 #include "../config.h"
 
+// Logged event types
+enum dccLogEvent : uint8_t {
+    DCC_LOG_PACKET,         // Accessory packet received (address = DCC address)
+    DCC_LOG_SERVO_ACTION,   // Servo commanded by DCC (address = GPIO pin)
+    DCC_LOG_SIGNAL,         // DCC signal LED triggered
+    DCC_LOG_ASPECT_PACKET,  // Extended accessory (signal aspect) packet received (address = DCC address)
+    DCC_LOG_SERVO_ASPECT    // Servo set to a signal aspect by DCC (address = GPIO pin)
+};
+
+// DccLogRecord flags
+#define DCC_LOG_DIRECTION 0x01  // Set = thrown (Direction 1)
+#define DCC_LOG_POWER 0x02      // Output power bit
+#define DCC_LOG_MATCH 0x04      // Address belongs to one of our servos
+#define DCC_LOG_ASPECT_SHIFT 3  // Aspect events: aspect number in the bits above DCC_LOG_MATCH
+
+// Fixed-size binary log record
+struct DccLogRecord {
+    uint32_t timestamp;     // millis()
+    uint16_t address;
+    uint8_t event;          // dccLogEvent
+    uint8_t flags;          // DCC_LOG_* flags
+};
+
 /**
  * @brief DCC Debug Logger for managing DCC packet logging and debugging
  * 
- * This class provides a circular buffer for DCC debug messages with
- * timestamps and enables/disables debug mode functionality.
+ * Keeps a preallocated ring of binary records, so logging from the DCC
+ * callback never touches the heap. Records are only turned into text when
+ * the log is read (serial or web).
+ * 
+ * Every record has a sequence number, counting up from 0 at boot and never
+ * reused (not even by clearLog()). It is implied by the record's position:
+ * the oldest record held is getFirstSequence(), the next one logged will be
+ * getNextSequence(). Readers keep a cursor and fetch only what is new.
+ *
+ * With debug mode on, update() is one such reader: it echoes new records
+ * from loop(), never from the DCC callback, through the diagnostic log
+ * (info level, rate-limited like any other diagnostic output).
  */
 class DccDebugLogger {
 private:
-    String logBuffer[DCC_LOG_SIZE];
-    unsigned long logTimestamp[DCC_LOG_SIZE];
-    int logIndex;
-    int logCount;
+    DccLogRecord records[DCC_LOG_SIZE];
+    uint16_t logIndex;
+    uint16_t logCount;
+    uint32_t nextSequence;  // Sequence number the next record will get
+    uint32_t echoSequence;  // Next record update() echoes to serial
     bool debugEnabled;
 
+    /**
+     * @brief Append a record, overwriting the oldest when the ring is full
+     */
+    void addRecord(uint16_t address, uint8_t event, uint8_t flags);
+
 public:
     /**
      * @brief Construct a new DCC Debug Logger
@@ -25,20 +64,58 @@ public:
     DccDebugLogger();
 
     /**
-     * @brief Add a message to the debug log
-     * @param message Debug message to log
+     * @brief Log a received accessory packet
+     * @param address DCC accessory address
+     * @param direction 0 = closed, 1 = thrown
+     * @param power Output power bit
+     * @param match true if the address belongs to one of our servos
+     */
+    void logPacket(uint16_t address, uint8_t direction, uint8_t power, bool match);
+
+    /**
+     * @brief Log a servo commanded by a DCC packet
+     * @param pin GPIO pin of the servo
+     * @param direction 0 = closed, 1 = thrown
+     */
+    void logServoAction(uint8_t pin, uint8_t direction);
+
+    /**
+     * @brief Log a received extended accessory (signal aspect) packet
+     * @param address DCC accessory address
+     * @param aspect Aspect number (0-31)
+     * @param match true if the address belongs to one of our servos
+     */
+    void logAspectPacket(uint16_t address, uint8_t aspect, bool match);
+
+    /**
+     * @brief Log a servo set to a signal aspect by a DCC packet
+     * @param pin GPIO pin of the servo
+     * @param aspect Aspect number
+     */
+    void logServoAspect(uint8_t pin, uint8_t aspect);
+
+    /**
+     * @brief Log the DCC signal LED being triggered
      */
-    void addMessage(const String& message);
+    void logSignal();
 
     /**
      * @brief Toggle debug mode on/off
      */
     void toggleDebug();
 
+    /**
+     * @brief Echo records logged since the last call (debug mode only); call from loop()
+     */
+    void update();
+
     /**
      * @brief Enable debug mode
      */
-    void enableDebug() { debugEnabled = true; }
+    void enableDebug() {
+        if (!debugEnabled) echoSequence = nextSequence;  // Echo from now on, not the backlog
+        debugEnabled = true;
+    }
 
     /**
      * @brief Disable debug mode
@@ -53,10 +130,47 @@ public:
 
     /**
      * @brief Get the current log count
-     * @return Number of messages in the log
+     * @return Number of records in the log
      */
     int getLogCount() const { return logCount; }
 
+    /**
+     * @brief Get a log record
+     * @param index 0 = oldest record
+     * @param record Receives the record
+     * @return false if index is out of range
+     */
+    bool getRecord(int index, DccLogRecord &record) const;
+
+    /**
+     * @brief Sequence number of the oldest record still held
+     */
+    uint32_t getFirstSequence() const { return nextSequence - logCount; }
+
+    /**
+     * @brief Sequence number the next record will get
+     */
+    uint32_t getNextSequence() const { return nextSequence; }
+
+    /**
+     * @brief Get a log record by sequence number
+     * @param sequence Sequence number
+     * @param record Receives the record
+     * @return false if the record has been overwritten or not yet logged
+     */
+    bool getRecordBySequence(uint32_t sequence, DccLogRecord &record) const {
+        return getRecord((int32_t)(sequence - getFirstSequence()), record);
+    }
+
+    /**
+     * @brief Format a record's message (without timestamp)
+     * @param record Record to format
+     * @param buffer Output buffer
+     * @param size Size of buffer
+     * @return Length of the message
+     */
+    static size_t formatMessage(const DccLogRecord &record, char *buffer, size_t size);
+
     /**
      * @brief Get log message at index
      * @param index Index in the log buffer
@@ -78,7 +192,7 @@ public:
 
     /**
      * @brief Get formatted log for web interface
-     * @return HTML formatted log string
+     * @return HTML table of the most recent DCC_LOG_WEB_ENTRIES records
      */
     String getFormattedLogHtml() const;
 
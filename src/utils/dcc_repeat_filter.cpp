@@ -0,0 +1,51 @@
+#include "dcc_repeat_filter.h"
+
+// Global instance
+DccRepeatFilter dccRepeatFilter;
+
+DccRepeatFilter::DccRepeatFilter() {
+    clear();
+}
+
+bool DccRepeatFilter::accept(uint16_t address, uint8_t direction) {
+    uint32_t now = millis();
+    DccRepeatEntry *entry = nullptr;
+
+    for (uint8_t i = 0; i < used; i++) {
+        if (entries[i].address == address) {
+            entry = &entries[i];
+            break;
+        }
+    }
+
+    if (entry == nullptr) {
+        if (used < DCC_REPEAT_FILTER_SLOTS) {
+            entry = &entries[used++];
+        } else {
+            // Addresses were changed: take over the one heard from longest ago
+            entry = &entries[0];
+            for (uint8_t i = 1; i < used; i++) {
+                if (now - entries[i].timeMs > now - entry->timeMs) entry = &entries[i];
+            }
+        }
+        entry->address = address;
+    } else if (entry->direction != direction) {
+        reversalCount++;
+    } else if (now - entry->timeMs < DCC_REPEAT_WINDOW_MS) {
+        suppressedCount++;
+        return false;
+    }
+
+    entry->direction = direction;
+    entry->timeMs = now;
+    acceptedCount++;
+    return true;
+}
+
+void DccRepeatFilter::clear() {
+    memset(entries, 0, sizeof(entries));
+    used = 0;
+    acceptedCount = 0;
+    suppressedCount = 0;
+    reversalCount = 0;
+}
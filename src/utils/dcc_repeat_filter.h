@@ -0,0 +1,68 @@
+#ifndef DCC_REPEAT_FILTER_H
+#define DCC_REPEAT_FILTER_H
+
+#include <Arduino.h>
+#include "../config.h"
+
+#define DCC_REPEAT_FILTER_SLOTS TOTAL_PINS  // Addresses tracked (at most one per servo is ours)
+
+// Last command accepted for an address
+struct DccRepeatEntry {
+    uint16_t address;
+    uint8_t direction;
+    uint8_t reserved;
+    uint32_t timeMs;        // millis() when it was accepted
+};
+
+/**
+ * @brief Collapses repeated accessory packets into one command
+ *
+ * Command stations send every accessory command several times, often as an
+ * OutputPower=1 packet followed by an OutputPower=0 one. A packet with the
+ * same address and direction as the command accepted for that address less
+ * than DCC_REPEAT_WINDOW_MS earlier is a repeat: it is counted and ignored.
+ * A different direction is a new command and passes at once. The window is
+ * measured from the accepted command, so a station that keeps repeating
+ * gets through once per window at most.
+ *
+ * Only our addresses are filtered, so the table holds one entry per owned
+ * address; when the servo addresses change, the oldest entry is reused.
+ */
+class DccRepeatFilter {
+private:
+    DccRepeatEntry entries[DCC_REPEAT_FILTER_SLOTS];
+    uint8_t used;
+
+    // Statistics
+    uint32_t acceptedCount;
+    uint32_t suppressedCount;
+    uint32_t reversalCount;
+
+public:
+    /**
+     * @brief Construct an empty filter
+     */
+    DccRepeatFilter();
+
+    /**
+     * @brief Check a packet against the last command for its address
+     * @param address DCC accessory address (one of ours)
+     * @param direction 0 = closed, 1 = thrown; signal aspects as their servo command target
+     * @return true to act on the packet, false for a repeat
+     */
+    bool accept(uint16_t address, uint8_t direction);
+
+    /**
+     * @brief Forget all addresses and clear the counters
+     */
+    void clear();
+
+    uint32_t getAcceptedCount() const { return acceptedCount; }
+    uint32_t getSuppressedCount() const { return suppressedCount; }
+    uint32_t getReversalCount() const { return reversalCount; }
+};
+
+// Global instance
+extern DccRepeatFilter dccRepeatFilter;
+
+#endif // DCC_REPEAT_FILTER_H
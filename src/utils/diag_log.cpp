@@ -0,0 +1,133 @@
+#include "diag_log.h"
+#include <stdarg.h>
+
+static_assert((DIAG_RING_SIZE & (DIAG_RING_SIZE - 1)) == 0, "DIAG_RING_SIZE must be a power of two");
+
+#define DIAG_DRAIN_CHUNK 128    // Bytes copied out of the ring per UART write (the ESP32 UART FIFO size)
+
+// Global instance
+DiagLog diagLog;
+
+DiagLog::DiagLog()
+    : head(0)
+    , tail(0)
+    , level(DIAG_LEVEL_DEFAULT > DIAG_LEVEL_MAX ? DIAG_LEVEL_MAX : DIAG_LEVEL_DEFAULT)
+    , taskHandle(nullptr)
+    , tokens(DIAG_BURST)
+    , refillMs(0) {
+    resetStats();
+}
+
+void DiagLog::begin() {
+    if (taskHandle != nullptr) return;
+
+    BaseType_t result = xTaskCreatePinnedToCore(taskEntry, "diag", DIAG_TASK_STACK_SIZE, this,
+                                                DIAG_TASK_PRIORITY, &taskHandle, DIAG_TASK_CORE);
+    if (result != pdPASS) {
+        taskHandle = nullptr;
+        Serial.println("✗ Failed to start diagnostic output task");
+    }
+}
+
+void DiagLog::taskEntry(void *param) {
+    DiagLog *self = static_cast<DiagLog *>(param);
+
+    for (;;) {
+        self->drain();
+        vTaskDelay(pdMS_TO_TICKS(DIAG_DRAIN_INTERVAL_MS));
+    }
+}
+
+bool DiagLog::log(uint8_t messageLevel, const char *format, ...) {
+    if (!isEnabled(messageLevel)) return false;
+
+    char line[DIAG_LINE_MAX];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line) - 1, format, args);
+    va_end(args);
+    if (length < 0) return false;
+    if (length > (int)sizeof(line) - 2) length = sizeof(line) - 2;  // Truncated
+    line[length++] = '\n';
+
+    uint32_t now = millis();
+    bool queued = false;
+
+    portENTER_CRITICAL(&mux);
+    uint32_t elapsed = now - refillMs;
+    uint32_t refill = elapsed * DIAG_RATE_PER_SEC / 1000;
+    if (elapsed >= DIAG_BURST * 1000UL / DIAG_RATE_PER_SEC) {
+        tokens = DIAG_BURST;  // Quiet long enough to refill completely
+        refillMs = now;
+    } else if (refill > 0) {
+        tokens = (tokens + refill > DIAG_BURST) ? DIAG_BURST : tokens + refill;
+        refillMs += refill * 1000 / DIAG_RATE_PER_SEC;
+    }
+    if (tokens == 0) {
+        rateDropCount++;
+    } else if (DIAG_RING_SIZE - (head - tail) < (uint32_t)length) {
+        fullDropCount++;
+    } else {
+        tokens--;
+        for (int i = 0; i < length; i++) {
+            ring[(head + i) & (DIAG_RING_SIZE - 1)] = line[i];
+        }
+        head += length;
+        if (head - tail > peakUsed) peakUsed = head - tail;
+        loggedCount++;
+        queued = true;
+    }
+    portEXIT_CRITICAL(&mux);
+
+    return queued;
+}
+
+size_t DiagLog::drain() {
+    size_t written = 0;
+
+    for (;;) {
+        int room = Serial.availableForWrite();
+        char chunk[DIAG_DRAIN_CHUNK];
+        uint32_t count;
+
+        // Only this task moves tail, so the bytes stay put after the lock is released
+        portENTER_CRITICAL(&mux);
+        count = head - tail;
+        if (count > sizeof(chunk)) count = sizeof(chunk);
+        if (room >= 0 && count > (uint32_t)room) count = room;
+        for (uint32_t i = 0; i < count; i++) {
+            chunk[i] = ring[(tail + i) & (DIAG_RING_SIZE - 1)];
+        }
+        portEXIT_CRITICAL(&mux);
+
+        // Whole lines only, so they do not interleave with direct Serial output
+        while (count > 0 && chunk[count - 1] != '\n') {
+            count--;
+        }
+        if (count == 0) break;
+
+        Serial.write((const uint8_t *)chunk, count);
+        portENTER_CRITICAL(&mux);
+        tail += count;
+        portEXIT_CRITICAL(&mux);
+        written += count;
+    }
+    return written;
+}
+
+void DiagLog::resetStats() {
+    loggedCount = 0;
+    rateDropCount = 0;
+    fullDropCount = 0;
+    peakUsed = head - tail;
+}
+
+const char *DiagLog::getLevelName(uint8_t messageLevel) {
+    switch (messageLevel) {
+        case DIAG_LEVEL_ERROR: return "error";
+        case DIAG_LEVEL_WARN: return "warn";
+        case DIAG_LEVEL_INFO: return "info";
+        case DIAG_LEVEL_DEBUG: return "debug";
+        default: return "none";
+    }
+}
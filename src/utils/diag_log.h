@@ -0,0 +1,124 @@
+#ifndef DIAG_LOG_H
+#define DIAG_LOG_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config.h"
+
+// Verbosity levels
+#define DIAG_LEVEL_NONE 0
+#define DIAG_LEVEL_ERROR 1
+#define DIAG_LEVEL_WARN 2
+#define DIAG_LEVEL_INFO 3
+#define DIAG_LEVEL_DEBUG 4
+
+/**
+ * @brief Leveled, rate-limited diagnostic output
+ *
+ * Messages are formatted into a line buffer on the caller's stack and copied
+ * into a ring; a low-priority task writes whole lines to Serial only as fast
+ * as the UART FIFO takes them. Logging never waits on the UART: when the ring
+ * is full, or messages come faster than DIAG_RATE_PER_SEC (after a burst of
+ * DIAG_BURST), the message is dropped and counted.
+ *
+ * Messages above the runtime level are not formatted at all, and the DIAG_*
+ * macros compile out messages above DIAG_LEVEL_MAX.
+ */
+class DiagLog {
+private:
+    char ring[DIAG_RING_SIZE];
+    uint32_t head;              // Next byte written (free-running)
+    uint32_t tail;              // Next byte drained (free-running)
+    uint8_t level;
+    TaskHandle_t taskHandle;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;  // Any task may log
+
+    // Rate limit (token bucket, in messages)
+    uint32_t tokens;
+    uint32_t refillMs;
+
+    // Statistics
+    uint32_t loggedCount;
+    uint32_t rateDropCount;
+    uint32_t fullDropCount;
+    uint32_t peakUsed;
+
+    /**
+     * @brief FreeRTOS task entry point
+     */
+    static void taskEntry(void *param);
+
+public:
+    /**
+     * @brief Construct an empty log at DIAG_LEVEL_DEFAULT (not draining)
+     */
+    DiagLog();
+
+    /**
+     * @brief Start the drain task, pinned to DIAG_TASK_CORE
+     */
+    void begin();
+
+    /**
+     * @brief Queue a message (a newline is added)
+     * @param messageLevel DIAG_LEVEL_ERROR ... DIAG_LEVEL_DEBUG
+     * @return false if the message was filtered or dropped
+     */
+    bool log(uint8_t messageLevel, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+    /**
+     * @brief Write queued lines that fit in the UART transmit buffer
+     *
+     * Called by the task; exposed so a host build can drain the ring directly.
+     * @return Bytes written
+     */
+    size_t drain();
+
+    /**
+     * @brief Check if messages of a level are logged
+     */
+    bool isEnabled(uint8_t messageLevel) const { return messageLevel <= level; }
+
+    /**
+     * @brief Set the runtime level (capped at DIAG_LEVEL_MAX)
+     */
+    void setLevel(uint8_t newLevel) { level = newLevel > DIAG_LEVEL_MAX ? DIAG_LEVEL_MAX : newLevel; }
+
+    /**
+     * @brief Clear the counters
+     */
+    void resetStats();
+
+    /**
+     * @brief Name of a level ("error", "warn", "info", "debug", "none")
+     */
+    static const char *getLevelName(uint8_t messageLevel);
+
+    uint8_t getLevel() const { return level; }
+    bool isRunning() const { return taskHandle != nullptr; }
+    uint32_t getLoggedCount() const { return loggedCount; }
+    uint32_t getRateDropCount() const { return rateDropCount; }
+    uint32_t getFullDropCount() const { return fullDropCount; }
+    uint32_t getDroppedCount() const { return rateDropCount + fullDropCount; }
+    uint32_t getQueuedBytes() const { return head - tail; }
+    uint32_t getPeakQueuedBytes() const { return peakUsed; }
+};
+
+// Global instance
+extern DiagLog diagLog;
+
+// Leveled logging; messages above DIAG_LEVEL_MAX are removed at compile time
+#define DIAG_LOG(messageLevel, ...) \
+    do { \
+        if ((messageLevel) <= DIAG_LEVEL_MAX && diagLog.isEnabled(messageLevel)) { \
+            diagLog.log((messageLevel), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define DIAG_ERROR(...) DIAG_LOG(DIAG_LEVEL_ERROR, __VA_ARGS__)
+#define DIAG_WARN(...) DIAG_LOG(DIAG_LEVEL_WARN, __VA_ARGS__)
+#define DIAG_INFO(...) DIAG_LOG(DIAG_LEVEL_INFO, __VA_ARGS__)
+#define DIAG_DEBUG(...) DIAG_LOG(DIAG_LEVEL_DEBUG, __VA_ARGS__)
+
+#endif // DIAG_LOG_H
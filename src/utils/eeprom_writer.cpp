@@ -0,0 +1,111 @@
+#include "eeprom_writer.h"
+#include "config_journal.h"
+#include "diag_log.h"
+
+// Global instance
+EepromWriter eepromWriter;
+
+EepromWriter::EepromWriter()
+    : dirtyStart(0)
+    , dirtyEnd(0)
+    , firstChangeMs(0)
+    , lastChangeMs(0)
+    , lifetimeCommits(0)
+    , commitCount(0)
+    , putCount(0)
+    , unchangedCount(0)
+    , failedCount(0)
+    , bytesCommitted(0)
+    , lastCommitUs(0)
+    , maxCommitUs(0) {
+}
+
+void EepromWriter::begin() {
+    EEPROM.get(EEPROM_COMMIT_COUNT_ADDRESS, lifetimeCommits);
+    if (lifetimeCommits == 0xFFFFFFFF) {
+        lifetimeCommits = 0;  // Erased flash
+    }
+}
+
+bool EepromWriter::putBytes(int address, const uint8_t *bytes, size_t length) {
+    putCount++;
+
+    // Only bytes that differ from the RAM copy make the region dirty
+    int first = -1;
+    int last = -1;
+    for (size_t i = 0; i < length; i++) {
+        if (EEPROM.read(address + i) != bytes[i]) {
+            EEPROM.write(address + i, bytes[i]);
+            if (first < 0) first = i;
+            last = i;
+        }
+    }
+
+    if (first < 0) {
+        unchangedCount++;
+        return false;
+    }
+
+    uint16_t start = address + first;
+    uint16_t end = address + last + 1;
+    if (!isPending()) {
+        dirtyStart = start;
+        dirtyEnd = end;
+        firstChangeMs = millis();
+    } else {
+        if (start < dirtyStart) dirtyStart = start;
+        if (end > dirtyEnd) dirtyEnd = end;
+    }
+    lastChangeMs = millis();
+    return true;
+}
+
+void EepromWriter::update() {
+    if (!isPending()) return;
+
+    uint32_t now = millis();
+    if ((now - lastChangeMs >= EEPROM_WRITE_DELAY_MS) || (now - firstChangeMs >= EEPROM_WRITE_MAX_DELAY_MS)) {
+        flush();
+    }
+}
+
+bool EepromWriter::flush() {
+    if (!isPending()) return false;
+
+    // The counter rides along with the commit it counts
+    EEPROM.put(EEPROM_COMMIT_COUNT_ADDRESS, lifetimeCommits + 1);
+
+    // The journal appends only the changed bytes; without it the whole
+    // image is rewritten
+    uint32_t startUs = micros();
+    bool committed;
+    if (configJournal.isReady()) {
+        committed = configJournal.append(EEPROM.getDataPtr());
+    } else {
+        committed = EEPROM.commit(); // ESP32 specific - commit changes to flash
+    }
+    lastCommitUs = micros() - startUs;
+    if (lastCommitUs > maxCommitUs) maxCommitUs = lastCommitUs;
+
+    if (!committed) {
+        // Still pending: retried once the quiet period has passed again. Boot
+        // reads the journal when there is one, so a whole-image commit is no fallback
+        EEPROM.put(EEPROM_COMMIT_COUNT_ADDRESS, lifetimeCommits);
+        failedCount++;
+        firstChangeMs = lastChangeMs = millis();
+        DIAG_ERROR("Settings NOT saved: flash write failed (%u bytes pending, retry in %d ms)", getPendingBytes(),
+                   EEPROM_WRITE_DELAY_MS);
+        return false;
+    }
+
+    lifetimeCommits++;
+
+    commitCount++;
+    bytesCommitted += getPendingBytes();
+    Serial.printf("Settings saved to EEPROM (%u bytes changed, %lu us)\n",
+                  getPendingBytes(), (unsigned long)lastCommitUs);
+
+    dirtyStart = 0;
+    dirtyEnd = 0;
+    return true;
+}
@@ -0,0 +1,98 @@
+#ifndef EEPROM_WRITER_H
+#define EEPROM_WRITER_H
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "../config.h"
+
+/**
+ * @brief Write-behind front end for the emulated EEPROM
+ *
+ * put() only updates the EEPROM's RAM copy and remembers which bytes really
+ * changed. The flash commit (a sector erase and rewrite) is left to update(),
+ * which makes it once the settings have been quiet for EEPROM_WRITE_DELAY_MS,
+ * or EEPROM_WRITE_MAX_DELAY_MS after the first change if they keep changing,
+ * so a burst of saves (sliders, "Save All", scripts) costs one commit.
+ * flush() commits at once; it must run before ESP.restart(). A commit the
+ * flash refuses leaves the changes pending, to be retried after another
+ * quiet period.
+ *
+ * Commits are counted for this boot and for the life of the flash; the
+ * lifetime count is stored in the EEPROM itself and written with each commit.
+ */
+class EepromWriter {
+private:
+    uint16_t dirtyStart;        // Changed bytes not yet committed: [dirtyStart, dirtyEnd)
+    uint16_t dirtyEnd;
+    uint32_t firstChangeMs;
+    uint32_t lastChangeMs;
+
+    // Statistics
+    uint32_t lifetimeCommits;
+    uint32_t commitCount;
+    uint32_t putCount;
+    uint32_t unchangedCount;    // put() calls that changed nothing
+    uint32_t failedCount;       // Commits the flash refused
+    uint32_t bytesCommitted;
+    uint32_t lastCommitUs;
+    uint32_t maxCommitUs;
+
+    /**
+     * @brief Copy bytes into the EEPROM's RAM copy, marking those that differ
+     * @return true if any byte changed
+     */
+    bool putBytes(int address, const uint8_t *bytes, size_t length);
+
+public:
+    /**
+     * @brief Construct a writer with nothing pending
+     */
+    EepromWriter();
+
+    /**
+     * @brief Read the lifetime commit count (after EEPROM.begin())
+     */
+    void begin();
+
+    /**
+     * @brief Stage a value for the next commit
+     * @param address EEPROM address
+     * @param value Value to store
+     * @return true if the stored bytes changed
+     */
+    template <typename T> bool put(int address, const T &value) {
+        return putBytes(address, (const uint8_t *)&value, sizeof(T));
+    }
+
+    /**
+     * @brief Commit once the quiet period is over (call from loop())
+     */
+    void update();
+
+    /**
+     * @brief Commit pending changes now
+     * @return true if a commit was made; false if nothing was pending or the commit failed (still pending)
+     */
+    bool flush();
+
+    /**
+     * @brief Check if changes are waiting for a commit
+     * @return true if pending
+     */
+    bool isPending() const { return dirtyEnd > dirtyStart; }
+
+    uint16_t getPendingBytes() const { return dirtyEnd - dirtyStart; }
+    uint32_t getLifetimeCommits() const { return lifetimeCommits; }
+    uint32_t getCommitCount() const { return commitCount; }
+    uint32_t getPutCount() const { return putCount; }
+    uint32_t getUnchangedCount() const { return unchangedCount; }
+    uint32_t getFailedCount() const { return failedCount; }
+    uint32_t getBytesCommitted() const { return bytesCommitted; }
+    uint32_t getLastCommitUs() const { return lastCommitUs; }
+    uint32_t getMaxCommitUs() const { return maxCommitUs; }
+};
+
+// Global instance
+extern EepromWriter eepromWriter;
+
+#endif // EEPROM_WRITER_H
@@ -0,0 +1,84 @@
+#include "page_writer.h"
+
+PageWriter::PageWriter(WebServer &server)
+    : server(server), length(0), started(false) {
+}
+
+PageWriter::~PageWriter() {
+    end();
+}
+
+void PageWriter::begin(int code, const char *contentType) {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(code, contentType, "");
+    started = true;
+}
+
+void PageWriter::print(PGM_P text) {
+    size_t textLength = strlen_P(text);
+    
+    if (textLength >= sizeof(buffer) / 2) {
+        // Large fragment: send it from flash rather than copy it through the buffer
+        flush();
+        server.sendContent_P(text, textLength);
+        return;
+    }
+    
+    if (length + textLength > sizeof(buffer)) {
+        flush();
+    }
+    memcpy_P(buffer + length, text, textLength);
+    length += textLength;
+}
+
+void PageWriter::printf(const char *format, ...) {
+    va_list args;
+    
+    for (int attempt = 0; attempt < 2; attempt++) {
+        va_start(args, format);
+        int written = vsnprintf(buffer + length, sizeof(buffer) - length, format, args);
+        va_end(args);
+        
+        if (written < 0) return;
+        if (length + written < sizeof(buffer)) {
+            length += written;
+            return;
+        }
+        
+        // Did not fit: send what came before it and format again into an empty buffer
+        if (length == 0) break;
+        flush();
+    }
+    
+    // Longer than a whole chunk: keep what fitted
+    length = sizeof(buffer) - 1;
+}
+
+void PageWriter::write(const void *data, size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    
+    while (size > 0) {
+        if (length == sizeof(buffer)) {
+            flush();
+        }
+        size_t n = sizeof(buffer) - length;
+        if (n > size) n = size;
+        memcpy(buffer + length, bytes, n);
+        length += n;
+        bytes += n;
+        size -= n;
+    }
+}
+
+void PageWriter::flush() {
+    if (length == 0) return;
+    server.sendContent(buffer, length);
+    length = 0;
+}
+
+void PageWriter::end() {
+    if (!started) return;
+    flush();
+    server.sendContent("");
+    started = false;
+}
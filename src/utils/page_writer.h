@@ -0,0 +1,77 @@
+#ifndef PAGE_WRITER_H
+#define PAGE_WRITER_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "../config.h"
+
+/**
+ * @brief Streams a web page to the client with chunked transfer encoding
+ * 
+ * Pages are written as constant text (kept in flash) and small formatted
+ * values. Both are gathered in a WEB_PAGE_CHUNK_SIZE buffer inside the writer,
+ * which lives on the request handler's stack, and sent a chunk at a time, so
+ * a page never exists in RAM as a whole and rendering does not touch the heap.
+ * Constant text of at least half a chunk goes straight from flash.
+ */
+class PageWriter {
+private:
+    WebServer &server;
+    char buffer[WEB_PAGE_CHUNK_SIZE];
+    size_t length;
+    bool started;
+
+public:
+    /**
+     * @brief Construct a writer for the current request (nothing sent yet)
+     * @param server Web server handling the request
+     */
+    explicit PageWriter(WebServer &server);
+
+    /**
+     * @brief Finish the response if end() was not called
+     */
+    ~PageWriter();
+
+    PageWriter(const PageWriter &) = delete;
+    PageWriter &operator=(const PageWriter &) = delete;
+
+    /**
+     * @brief Send the status line and headers for a chunked response
+     * @param code HTTP status code
+     * @param contentType MIME type of the page
+     */
+    void begin(int code = 200, const char *contentType = "text/html");
+
+    /**
+     * @brief Write constant text
+     * @param text Null-terminated text, typically a PROGMEM page fragment
+     */
+    void print(PGM_P text);
+
+    /**
+     * @brief Write formatted values
+     * @param format printf-style format
+     */
+    void printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Write binary data
+     * @param data Bytes to send (in RAM)
+     * @param size Number of bytes
+     */
+    void write(const void *data, size_t size);
+
+    /**
+     * @brief Send what is buffered and the terminating chunk
+     */
+    void end();
+
+private:
+    /**
+     * @brief Send the buffered text as one chunk
+     */
+    void flush();
+};
+
+#endif // PAGE_WRITER_H
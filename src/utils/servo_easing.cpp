@@ -0,0 +1,81 @@
+#include "servo_easing.h"
+
+namespace {
+
+const int32_t EASING_ONE = 1L << SERVO_EASING_FRAC_BITS;
+const uint8_t SEGMENT_SHIFT = SERVO_EASING_PROGRESS_BITS - 6;  // 64 segments
+const uint32_t SEGMENT_MASK = (1UL << SEGMENT_SHIFT) - 1;
+
+static_assert((1 << (SERVO_EASING_PROGRESS_BITS - SEGMENT_SHIFT)) == SERVO_EASING_SEGMENTS,
+              "SEGMENT_SHIFT must match SERVO_EASING_SEGMENTS");
+
+struct EasingTable {
+    int16_t value[SERVO_EASING_SEGMENTS + 1];
+};
+
+// Curves over t = 0..1, evaluated by the compiler only
+constexpr double easeLinear(double t) {
+    return t;
+}
+
+constexpr double easeInOut(double t) {
+    return t * t * (3.0 - 2.0 * t);
+}
+
+constexpr double easeSCurve(double t) {
+    return t * t * t * (t * (t * 6.0 - 15.0) + 10.0);
+}
+
+constexpr double easeBounce(double t) {
+    // Back-out: overshoots by about 10% before settling on the end point
+    const double c1 = 1.70158;
+    const double c3 = c1 + 1.0;
+    return 1.0 + c3 * (t - 1.0) * (t - 1.0) * (t - 1.0) + c1 * (t - 1.0) * (t - 1.0);
+}
+
+constexpr EasingTable makeEasingTable(double (*curve)(double)) {
+    EasingTable table{};
+    for (int i = 0; i <= SERVO_EASING_SEGMENTS; i++) {
+        double y = curve((double)i / SERVO_EASING_SEGMENTS) * EASING_ONE;
+        table.value[i] = (int16_t)(y >= 0 ? y + 0.5 : y - 0.5);
+    }
+    return table;
+}
+
+constexpr EasingTable easingTables[EASING_COUNT] = {
+    makeEasingTable(easeLinear),
+    makeEasingTable(easeInOut),
+    makeEasingTable(easeSCurve),
+    makeEasingTable(easeBounce),
+};
+
+static_assert(easingTables[EASING_LINEAR].value[SERVO_EASING_SEGMENTS / 2] == EASING_ONE / 2,
+              "Linear table must be the identity");
+static_assert(easingTables[EASING_S_CURVE].value[0] == 0 &&
+              easingTables[EASING_S_CURVE].value[SERVO_EASING_SEGMENTS] == EASING_ONE,
+              "Profiles must start at 0 and end at 1");
+static_assert(easingTables[EASING_BOUNCE].value[SERVO_EASING_SEGMENTS] == EASING_ONE,
+              "Bounce must settle on the end point");
+
+const char* const easingNames[EASING_COUNT] = {
+    "Linear", "EaseInOut", "S-Curve", "Bounce"
+};
+
+} // namespace
+
+int32_t evaluateServoEasing(uint8_t profile, uint32_t progress) {
+    if (profile >= EASING_COUNT) profile = EASING_LINEAR;
+    
+    uint32_t segment = progress >> SEGMENT_SHIFT;
+    if (segment >= SERVO_EASING_SEGMENTS) {
+        return easingTables[profile].value[SERVO_EASING_SEGMENTS];
+    }
+    
+    int32_t a = easingTables[profile].value[segment];
+    int32_t b = easingTables[profile].value[segment + 1];
+    return a + (((b - a) * (int32_t)(progress & SEGMENT_MASK)) >> SEGMENT_SHIFT);
+}
+
+const char* getServoEasingName(uint8_t profile) {
+    return (profile < EASING_COUNT) ? easingNames[profile] : "Unknown";
+}
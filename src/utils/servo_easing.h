@@ -0,0 +1,39 @@
+#ifndef SERVO_EASING_H
+#define SERVO_EASING_H
+
+#include <Arduino.h>
+
+#define SERVO_EASING_SEGMENTS 64      // Table entries - 1 (power of two)
+#define SERVO_EASING_FRAC_BITS 14     // Curve values are fixed point, 1.0 = 1 << 14
+#define SERVO_EASING_PROGRESS_BITS 16 // Move progress is fixed point, 1.0 = 1 << 16
+
+// Easing profiles (stored per servo)
+enum servoEasing {
+    EASING_LINEAR = 0,    // Constant velocity
+    EASING_EASE_IN_OUT,   // Smoothstep: gentle start and stop
+    EASING_S_CURVE,       // Smootherstep: zero velocity and acceleration at both ends
+    EASING_BOUNCE,        // Overshoot the end point and settle back
+    EASING_COUNT
+};
+
+/**
+ * @brief Evaluate an easing profile
+ * 
+ * The curves are sampled into lookup tables at compile time, so evaluation is
+ * one table lookup and one linear interpolation between neighbouring samples.
+ * 
+ * @param profile Easing profile (servoEasing)
+ * @param progress Move progress, 0 to 1 << SERVO_EASING_PROGRESS_BITS
+ * @return Eased fraction of the move, 1.0 = 1 << SERVO_EASING_FRAC_BITS
+ *         (may leave 0..1 for overshooting profiles)
+ */
+int32_t evaluateServoEasing(uint8_t profile, uint32_t progress);
+
+/**
+ * @brief Get the display name of an easing profile
+ * @param profile Easing profile (servoEasing)
+ * @return Profile name, "Unknown" if out of range
+ */
+const char* getServoEasingName(uint8_t profile);
+
+#endif // SERVO_EASING_H
@@ -0,0 +1,138 @@
+#include "servo_state_log.h"
+
+#define SERVO_STATE_LOG_READ_WORDS 32
+#define SERVO_STATE_LOG_ERASED 0xFFFFFFFFUL
+
+// Global instance
+ServoStateLog servoStateLog;
+
+ServoStateLog::ServoStateLog()
+    : partition(nullptr)
+    , sector(0)
+    , sequence(0)
+    , nextSlot(0)
+    , state(0)
+    , stored(false)
+    , ready(false)
+    , latestState(0)
+    , changeMs(0)
+    , writeCount(0)
+    , eraseCount(0) {
+}
+
+bool ServoStateLog::begin(const char *label) {
+    ready = false;
+    stored = false;
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (partition == nullptr || partition->size < 2 * SERVO_STATE_LOG_SECTOR_SIZE) {
+        return false;
+    }
+
+    bool valid[2];
+    uint16_t sequences[2];
+    for (uint8_t i = 0; i < 2; i++) {
+        uint32_t word = SERVO_STATE_LOG_ERASED;
+        esp_partition_read(partition, slotAddress(i, 0), &word, sizeof(word));
+        valid[i] = unpack(word, sequences[i]);
+    }
+
+    if (valid[0] || valid[1]) {
+        if (valid[0] && valid[1]) {
+            sector = ((int16_t)(sequences[1] - sequences[0]) > 0) ? 1 : 0;
+        } else {
+            sector = valid[1] ? 1 : 0;
+        }
+        sequence = sequences[sector];
+        stored = scanSector(sector, state, nextSlot);
+    } else {
+        // Empty: the first write starts sector 0
+        sector = 1;
+        sequence = 0xFFFF;
+        nextSlot = SERVO_STATE_LOG_SLOTS;
+    }
+
+    latestState = state;
+    changeMs = millis();
+    ready = true;
+    return true;
+}
+
+bool ServoStateLog::scanSector(uint8_t sectorIndex, uint16_t &value, uint16_t &freeSlot) const {
+    uint32_t words[SERVO_STATE_LOG_READ_WORDS];
+    bool found = false;
+
+    // Slots are written in order, so the first erased one ends the log
+    for (uint16_t base = 0; base < SERVO_STATE_LOG_SLOTS; base += SERVO_STATE_LOG_READ_WORDS) {
+        esp_partition_read(partition, slotAddress(sectorIndex, base), words, sizeof(words));
+        for (uint16_t n = (base == 0) ? 1 : 0; n < SERVO_STATE_LOG_READ_WORDS; n++) {
+            uint16_t slotValue;
+            if (words[n] == SERVO_STATE_LOG_ERASED) {
+                freeSlot = base + n;
+                return found;
+            }
+            if (unpack(words[n], slotValue)) {
+                value = slotValue;
+                found = true;
+            }
+            // Otherwise torn by a power cut: skipped
+        }
+    }
+    freeSlot = SERVO_STATE_LOG_SLOTS;
+    return found;
+}
+
+bool ServoStateLog::startSector(uint16_t value) {
+    uint8_t next = sector ^ 1;
+    if (esp_partition_erase_range(partition, slotAddress(next, 0), SERVO_STATE_LOG_SECTOR_SIZE) != ESP_OK) {
+        return false;
+    }
+    eraseCount++;
+
+    // The sequence number goes last: until then the old sector stays current
+    uint32_t first = pack(value);
+    uint32_t header = pack(sequence + 1);
+    if ((esp_partition_write(partition, slotAddress(next, 1), &first, sizeof(first)) != ESP_OK) ||
+        (esp_partition_write(partition, slotAddress(next, 0), &header, sizeof(header)) != ESP_OK)) {
+        return false;
+    }
+
+    sector = next;
+    sequence++;
+    nextSlot = 2;
+    return true;
+}
+
+bool ServoStateLog::write(uint16_t value) {
+    if (!ready) return false;
+
+    bool ok;
+    if (nextSlot >= SERVO_STATE_LOG_SLOTS) {
+        ok = startSector(value);
+    } else {
+        uint32_t word = pack(value);
+        ok = (esp_partition_write(partition, slotAddress(sector, nextSlot), &word, sizeof(word)) == ESP_OK);
+        nextSlot++;  // Never program a slot twice, even one that failed
+    }
+    if (!ok) return false;
+
+    state = value;
+    stored = true;
+    writeCount++;
+    return true;
+}
+
+void ServoStateLog::update(uint16_t current) {
+    if (!ready) return;
+
+    uint32_t now = millis();
+    if (current != latestState) {
+        latestState = current;
+        changeMs = now;
+        return;
+    }
+    if (isPending() && (now - changeMs >= SERVO_STATE_WRITE_DELAY_MS)) {
+        if (!write(latestState)) {
+            changeMs = now;  // Try again after another delay
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef SERVO_STATE_LOG_H
+#define SERVO_STATE_LOG_H
+
+#include <Arduino.h>
+#include <esp_partition.h>
+#include "../config.h"
+
+#define SERVO_STATE_LOG_SECTOR_SIZE 4096
+#define SERVO_STATE_LOG_SLOTS (SERVO_STATE_LOG_SECTOR_SIZE / 4)   // Slot 0 holds the sector's sequence number
+
+static_assert(TOTAL_PINS <= 16, "Servo states are stored one bit per servo in 16 bits");
+
+/**
+ * @brief Last settled servo states, one bit per servo (1 = thrown), in flash
+ *
+ * The partition holds two 4 KB sectors used in turn. Each write programs the
+ * next free 32-bit slot of the current sector with the 16 state bits and
+ * their complement: a change costs 4 bytes of flash and no erase. A slot torn
+ * by a power cut fails the complement check and the one before it counts.
+ *
+ * Slot 0 of each sector holds its sequence number in the same form; the valid
+ * sector with the newer one is current. When it is full the other sector is
+ * erased, given the state in slot 1 and only then its sequence number, so it
+ * takes over in one step. Each sector is erased once per 2046 writes.
+ */
+class ServoStateLog {
+private:
+    const esp_partition_t *partition;
+    uint8_t sector;             // Current sector
+    uint16_t sequence;          // Sequence number of the current sector
+    uint16_t nextSlot;          // First free slot in the current sector
+    uint16_t state;             // Last state written
+    bool stored;                // The log holds a state
+    bool ready;
+
+    // Write-behind: states are written once they stop changing
+    uint16_t latestState;
+    uint32_t changeMs;
+
+    // Statistics
+    uint32_t writeCount;
+    uint32_t eraseCount;
+
+    static uint32_t pack(uint16_t value) { return ((uint32_t)(uint16_t)~value << 16) | value; }
+    static bool unpack(uint32_t word, uint16_t &value) {
+        value = word & 0xFFFF;
+        return (word >> 16) == (uint16_t)~value;
+    }
+
+    uint32_t slotAddress(uint8_t sectorIndex, uint16_t slot) const {
+        return (uint32_t)sectorIndex * SERVO_STATE_LOG_SECTOR_SIZE + slot * 4;
+    }
+
+    /**
+     * @brief Find the last valid state in a sector and the first free slot
+     * @return true if the sector holds a state
+     */
+    bool scanSector(uint8_t sectorIndex, uint16_t &value, uint16_t &freeSlot) const;
+
+    /**
+     * @brief Erase the other sector and make it current, holding value
+     */
+    bool startSector(uint16_t value);
+
+public:
+    /**
+     * @brief Construct a log (not attached to flash)
+     */
+    ServoStateLog();
+
+    /**
+     * @brief Find the partition and read the last state written
+     * @param label Partition label
+     * @return false if there is no such partition (states are not kept)
+     */
+    bool begin(const char *label);
+
+    /**
+     * @brief Write the states once they have been unchanged for SERVO_STATE_WRITE_DELAY_MS
+     *
+     * Call from loop(); cheap when nothing changed.
+     * @param current Settled states now, one bit per servo
+     */
+    void update(uint16_t current);
+
+    /**
+     * @brief Write states now
+     * @param value One bit per servo, 1 = thrown
+     * @return false on a flash error
+     */
+    bool write(uint16_t value);
+
+    /**
+     * @brief Check if a state was found or written
+     * @return true if getState() is meaningful
+     */
+    bool hasState() const { return stored; }
+
+    uint16_t getState() const { return state; }
+    bool isReady() const { return ready; }
+    bool isPending() const { return ready && (!stored || latestState != state); }
+    uint16_t getSlot() const { return nextSlot; }
+    uint32_t getWriteCount() const { return writeCount; }
+    uint32_t getEraseCount() const { return eraseCount; }
+};
+
+// Global instance
+extern ServoStateLog servoStateLog;
+
+#endif // SERVO_STATE_LOG_H
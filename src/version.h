@@ -2,17 +2,17 @@
 #define VERSION_H
 
 // Software version information
-#define SOFTWARE_VERSION "v0.4.3"
+#define SOFTWARE_VERSION "v0.5.0"
 #define VERSION_MAJOR 0
-#define VERSION_MINOR 4
-#define VERSION_PATCH 3
+#define VERSION_MINOR 5
+#define VERSION_PATCH 0
 
 // Numeric version for EEPROM compatibility (MAJOR*100 + MINOR*10 + PATCH)
-#define VERSION_NUMERIC 403
-#define NUMERIC_VERSION 403
+#define VERSION_NUMERIC 500
+#define NUMERIC_VERSION 500
 
 // Build information
-#define BUILD_DATE "2025-07-30"
+#define BUILD_DATE "2026-10-16"
 #define BUILD_TIME __TIME__
 
 // Project information
@@ -22,6 +22,22 @@
 
 // Version history and features
 #define VERSION_HISTORY \
+"v0.5.0 (2026-10-16):\n" \
+"  + TIME-BASED MOTION ENGINE: Servo position kept in fixed-point microseconds\n" \
+"  + Motion follows elapsed time, so late updates no longer stretch travel time\n" \
+"  + Servo output via writeMicroseconds for smooth sub-degree movement\n" \
+"  + Speed is now degrees/second; presets 0-3 map to Instant/200/133/67 deg/s\n" \
+"  + Explicit speeds (4-1000 deg/s) accepted by the 's' command\n" \
+"  + Servo task runs updates at a fixed rate on core 1; 'stats' command and /stats endpoint\n" \
+"  + DCC address index and lock-free servo command queue\n" \
+"  + EASING PROFILES: Linear, EaseInOut, S-Curve and Bounce (overshoot and settle)\n" \
+"  + Profiles are compile-time lookup tables, one lookup and interpolation per tick\n" \
+"  + Per-servo easing set via optional 8th 's' parameter and the servo config page\n" \
+"  + VERSIONED SETTINGS: EEPROM holds tagged records, each with a layout version and CRC-32\n" \
+"  + Settings from every earlier layout (v0.4.0 - v0.4.3) are migrated in place on first boot\n" \
+"  + A firmware update no longer resets servo settings; a damaged record alone falls back to defaults\n" \
+"  + WiFi settings are validated by their CRC instead of corruption heuristics\n" \
+"\n" \
 "v0.4.3 (2025-07-30):\n" \
 "  + HOSTNAME CONFIGURATION: Added customizable device hostname for mDNS\n" \
 "  + Users can now set custom hostname via web interface and serial commands\n" \
@@ -250,6 +266,8 @@
 "ESP32 DCC Servo Controller Features:\n" \
 "• 16 servo control with ESP32-compatible GPIO pins\n" \
 "• DCC accessory decoder integration\n" \
+"• Per-servo output addresses or a block of 4 board addresses, with optional +4 station shift\n" \
+"• Signal aspect (extended accessory) packets with an 8-position table per servo\n" \
 "• WiFi Access Point and Station modes\n" \
 "• Web-based configuration and servo control\n" \
 "• Default AP: DCCAC_[MAC6] / PASS_[MAC6]\n" \
@@ -269,7 +287,8 @@
 "• Individual servo configuration save capability\n" \
 "• Comprehensive servo control table with invert status display\n" \
 "• Mobile-responsive web interface design\n" \
-"• 4-speed movement control (Instant/Fast/Normal/Slow)\n" \
+"• Time-based movement control in degrees/second (Instant/Fast/Normal/Slow presets)\n" \
+"• Per-servo easing profiles (Linear/EaseInOut/S-Curve/Bounce)\n" \
 "• Per-servo offset adjustment for center position\n" \
 "• Dual numbering system (servo 0-15 + GPIO pins)\n" \
 "• Comprehensive serial and web command interfaces\n" \
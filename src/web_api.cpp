@@ -0,0 +1,319 @@
+#include "web_api.h"
+#include <ArduinoJson.h>
+#include "servo_controller.h"
+#include "eeprom_manager.h"
+#include "web_pages.h"
+#include "core/servo_task.h"
+#include "core/servo_command_queue.h"
+#include "utils/dcc_address_index.h"
+#include "utils/servo_easing.h"
+
+#define WEB_API_REPLY_SIZE 192
+#define WEB_API_TARGETS (SERVO_CMD_ASPECT + SERVO_ASPECT_COUNT)  // Servo command targets, aspects included
+
+static_assert(2 * WEB_API_TARGETS <= SERVO_COMMAND_QUEUE_SIZE, "A command batch must fit the servo command queue");
+
+// Handlers run one at a time in the main loop, so one request document,
+// allocated once, serves them all: parsing a request does not touch the heap.
+static StaticJsonDocument<WEB_API_DOC_SIZE> apiRequest;
+
+// The PATCHable part of a servo slot
+struct ServoSettings {
+    uint16_t address;
+    uint8_t swing;
+    int8_t offset;
+    uint16_t speed;
+    uint8_t easing;
+    bool invert;
+    uint8_t aspects[SERVO_ASPECT_COUNT];
+};
+
+/**
+ * @brief Send a small JSON reply
+ * @param server Web server handling the request
+ * @param code HTTP status code
+ * @param reply Filled-in reply document
+ */
+static void sendApiReply(WebServer &server, int code, JsonDocument &reply) {
+    char buffer[WEB_API_REPLY_SIZE];
+    reply["version"] = WEB_API_VERSION;
+    serializeJson(reply, buffer, sizeof(buffer));
+    server.send(code, "application/json", buffer);
+}
+
+/**
+ * @brief Reject a request
+ * @param index Offending entry in the request array, or -1
+ * @param field Offending field of that entry, or nullptr
+ */
+static void sendApiError(WebServer &server, int code, const char *message, int index = -1, const char *field = nullptr) {
+    StaticJsonDocument<WEB_API_REPLY_SIZE> reply;
+    reply["status"] = "error";
+    reply["message"] = message;
+    if (index >= 0) reply["index"] = index;
+    if (field != nullptr) reply["field"] = field;
+    sendApiReply(server, code, reply);
+}
+
+/**
+ * @brief Parse the request body into apiRequest and find its top-level array
+ * @param arrayName Member holding the array ("servos", "commands")
+ * @param missing Error message if there is no such array
+ * @return The array, or a null array after an error reply has been sent
+ */
+static JsonArrayConst parseApiRequest(WebServer &server, const char *arrayName, const char *missing) {
+    apiRequest.clear();
+    DeserializationError error = deserializeJson(apiRequest, server.arg("plain"));
+    if (error) {
+        if (error.code() == DeserializationError::NoMemory) {
+            sendApiError(server, 413, "Request too large");
+        } else {
+            sendApiError(server, 400, error.c_str());
+        }
+        return JsonArrayConst();
+    }
+
+    JsonArrayConst entries = apiRequest[arrayName].as<JsonArrayConst>();
+    if (entries.isNull()) {
+        sendApiError(server, 400, missing);
+    }
+    return entries;
+}
+
+int8_t parseServoCommandName(const char *name) {
+    if (strcmp(name, "close") == 0 || strcmp(name, "c") == 0) return SERVO_CMD_CLOSE;
+    if (strcmp(name, "throw") == 0 || strcmp(name, "t") == 0) return SERVO_CMD_THROW;
+    if (strcmp(name, "toggle") == 0 || strcmp(name, "T") == 0) return SERVO_CMD_TOGGLE;
+    if (strcmp(name, "neutral") == 0 || strcmp(name, "n") == 0) return SERVO_CMD_NEUTRAL;
+    if (name[0] == 'a' && name[1] >= '0' && name[1] < '0' + SERVO_ASPECT_COUNT && name[2] == '\0') {
+        return SERVO_CMD_ASPECT + (name[1] - '0');
+    }
+    return -1;
+}
+
+/**
+ * @brief Apply one PATCH entry to the staged settings
+ * @param entry {"servo":n, ...changed fields}
+ * @param staged Settings of all servos, updated in place
+ * @return Name of the first invalid field, or nullptr if the entry is valid
+ */
+static const char *stageServoPatch(JsonObjectConst entry, ServoSettings *staged) {
+    JsonVariantConst number = entry["servo"];
+    if (!number.is<int>() || number.as<int>() < 0 || number.as<int>() >= TOTAL_PINS) {
+        return "servo";
+    }
+    ServoSettings &settings = staged[number.as<int>()];
+
+    for (JsonPairConst field : entry) {
+        const char *key = field.key().c_str();
+        JsonVariantConst value = field.value();
+
+        if (strcmp(key, "servo") == 0) {
+            continue;
+        } else if (strcmp(key, "invert") == 0) {
+            if (!value.is<bool>()) return key;
+            settings.invert = value.as<bool>();
+            continue;
+        } else if (strcmp(key, "aspects") == 0) {
+            // Whole table: percent of travel per aspect, null for unused; aspects not listed are unused
+            JsonArrayConst list = value.as<JsonArrayConst>();
+            if (list.isNull()) return key;
+            memset(settings.aspects, SERVO_ASPECT_UNUSED, sizeof(settings.aspects));
+            uint8_t n = 0;
+            for (JsonVariantConst position : list) {
+                if (n >= SERVO_ASPECT_COUNT) return key;
+                if (!position.isNull()) {
+                    if (!position.is<int>() || position.as<int>() < 0 || position.as<int>() > 100) return key;
+                    settings.aspects[n] = position.as<int>();
+                }
+                n++;
+            }
+            continue;
+        }
+
+        if (!value.is<int>()) return key;
+        int v = value.as<int>();
+
+        if (strcmp(key, "address") == 0) {
+            if (v < 0 || v > DCC_MAX_ADDRESS) return key;
+            settings.address = v;
+        } else if (strcmp(key, "swing") == 0) {
+            if (v < 1 || v > 90) return key;
+            settings.swing = v;
+        } else if (strcmp(key, "offset") == 0) {
+            // Checked against the final swing once the whole entry is staged
+            if (v < -90 || v > 90) return key;
+            settings.offset = v;
+        } else if (strcmp(key, "speed") == 0) {
+            if (!parseServoSpeed(v, settings.speed)) return key;
+        } else if (strcmp(key, "easing") == 0) {
+            if (v < 0 || v >= EASING_COUNT) return key;
+            settings.easing = v;
+        } else {
+            return key;
+        }
+    }
+
+    if (!isValidOffset(settings.offset, settings.swing)) {
+        return "offset";
+    }
+    return nullptr;
+}
+
+// GET /api/v1/servos
+static void handleApiGetServos(WebServer &server) {
+    sendServoData(server);
+}
+
+// PATCH /api/v1/servos: all or nothing, one EEPROM commit
+static void handleApiPatchServos(WebServer &server) {
+    JsonArrayConst entries = parseApiRequest(server, "servos", "Expected a servos array");
+    if (entries.isNull()) return;
+
+    // Only the main loop changes configuration, so it can be read unlocked
+    ServoSettings staged[TOTAL_PINS];
+    for (int i = 0; i < TOTAL_PINS; i++) {
+        const VIRTUALSERVO &vs = virtualservo[i];
+        staged[i] = {vs.address, vs.swing, vs.offset, vs.speed, vs.easing, vs.invert, {}};
+        memcpy(staged[i].aspects, vs.aspects, sizeof(vs.aspects));
+    }
+
+    int index = 0;
+    for (JsonVariantConst item : entries) {
+        JsonObjectConst entry = item.as<JsonObjectConst>();
+        const char *invalid = entry.isNull() ? "servo" : stageServoPatch(entry, staged);
+        if (invalid != nullptr) {
+            sendApiError(server, 400, "Invalid value", index, invalid);
+            return;
+        }
+        index++;
+    }
+
+    uint8_t changed = 0;
+    {
+        // Hold off the servo tick while the slots are rewritten
+        ServoConfigLock lock;
+
+        for (int i = 0; i < TOTAL_PINS; i++) {
+            VIRTUALSERVO &vs = virtualservo[i];
+            const ServoSettings &s = staged[i];
+            if (s.address == vs.address && s.swing == vs.swing && s.offset == vs.offset &&
+                s.speed == vs.speed && s.easing == vs.easing && s.invert == vs.invert &&
+                memcmp(s.aspects, vs.aspects, sizeof(vs.aspects)) == 0) {
+                continue;
+            }
+            vs.address = s.address;
+            vs.swing = s.swing;
+            vs.offset = s.offset;
+            vs.speed = s.speed;
+            vs.easing = s.easing;
+            vs.invert = s.invert;
+            memcpy(vs.aspects, s.aspects, sizeof(vs.aspects));
+            changed++;
+        }
+
+        if (changed > 0) {
+            refreshServoConfig();
+        }
+    }
+
+    if (changed > 0) {
+        bootController.isDirty = true;
+        putSettings();
+        Serial.printf("API: %u servo configurations updated\n", changed);
+    }
+
+    StaticJsonDocument<WEB_API_REPLY_SIZE> reply;
+    reply["status"] = (changed > 0) ? "success" : "no_changes";
+    reply["changed"] = changed;
+    sendApiReply(server, 200, reply);
+}
+
+// POST /api/v1/commands: queued together, taken in one servo tick
+static void handleApiPostCommands(WebServer &server) {
+    JsonArrayConst entries = parseApiRequest(server, "commands", "Expected a commands array");
+    if (entries.isNull()) return;
+
+    // One servo mask per target and priority. A servo named twice ends in the
+    // group of its last command, so the batch needs at most 2 * WEB_API_TARGETS queue slots.
+    uint16_t groups[WEB_API_TARGETS][2] = {};
+    uint16_t commanded = 0;
+
+    int index = 0;
+    for (JsonVariantConst item : entries) {
+        JsonObjectConst entry = item.as<JsonObjectConst>();
+        uint16_t mask = 0;
+
+        if (entry["servo"].is<int>()) {
+            int servo = entry["servo"].as<int>();
+            if (servo < 0 || servo >= TOTAL_PINS) {
+                sendApiError(server, 400, "Invalid value", index, "servo");
+                return;
+            }
+            mask = 1U << servo;
+        } else if (entry["address"].is<int>()) {
+            int address = entry["address"].as<int>();
+            mask = (address > 0) ? dccAddressIndex.lookup(address) : 0;
+            if (mask == 0) {
+                sendApiError(server, 400, "No servo on this address", index, "address");
+                return;
+            }
+        } else {
+            sendApiError(server, 400, "Expected servo or address", index);
+            return;
+        }
+
+        const char *name = entry["command"].is<const char *>() ? entry["command"].as<const char *>() : "";
+        int8_t target = parseServoCommandName(name);
+        if (target < 0) {
+            sendApiError(server, 400, "Invalid value", index, "command");
+            return;
+        }
+        bool priority = entry["priority"].as<bool>();
+
+        for (auto &group : groups) {
+            group[0] &= ~mask;
+            group[1] &= ~mask;
+        }
+        groups[target][priority ? 1 : 0] |= mask;
+        commanded |= mask;
+        index++;
+    }
+
+    uint8_t slots = 0;
+    for (auto &group : groups) {
+        slots += (group[0] != 0) + (group[1] != 0);
+    }
+
+    bool queued = false;
+    {
+        // The servo task drains the whole queue in one tick; holding it off
+        // while the batch is queued keeps the batch from being split. We are
+        // the only producer, so the room checked here is still there below.
+        ServoConfigLock lock;
+
+        if (servoCommandQueue.getDepth() + slots <= SERVO_COMMAND_QUEUE_SIZE) {
+            for (uint8_t target = 0; target < WEB_API_TARGETS; target++) {
+                if (groups[target][1] != 0) servoCommandQueue.push(groups[target][1], target | SERVO_CMD_PRIORITY, SERVO_SRC_WEB);
+                if (groups[target][0] != 0) servoCommandQueue.push(groups[target][0], target, SERVO_SRC_WEB);
+            }
+            queued = true;
+        }
+    }
+
+    if (!queued) {
+        sendApiError(server, 503, "Servo command queue full");
+        return;
+    }
+
+    StaticJsonDocument<WEB_API_REPLY_SIZE> reply;
+    reply["status"] = "success";
+    reply["servos"] = __builtin_popcount(commanded);
+    sendApiReply(server, 200, reply);
+}
+
+void registerWebApi(WebServer &server) {
+    server.on(WEB_API_BASE "/servos", HTTP_GET, [&server]() { handleApiGetServos(server); });
+    server.on(WEB_API_BASE "/servos", HTTP_PATCH, [&server]() { handleApiPatchServos(server); });
+    server.on(WEB_API_BASE "/commands", HTTP_POST, [&server]() { handleApiPostCommands(server); });
+}
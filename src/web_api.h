@@ -0,0 +1,29 @@
+#ifndef WEB_API_H
+#define WEB_API_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "config.h"
+
+#define WEB_API_BASE "/api/v1"
+
+/*
+ * JSON REST API for scripting the whole layout in one request:
+ *
+ *   GET   /api/v1/servos    Configuration and state of every servo
+ *   PATCH /api/v1/servos    {"servos":[{"servo":3,"offset":-4,"speed":2},...]}
+ *                           All changes are validated first, then applied
+ *                           together and saved with one EEPROM commit
+ *   POST  /api/v1/commands  {"commands":[{"servo":3,"command":"throw"},
+ *                                        {"address":100,"command":"close"}]}
+ *                           Queued so the servo task takes them in one tick
+ *
+ * Replies carry "version":WEB_API_VERSION; errors are
+ * {"version":1,"status":"error","message":...,"index":n,"field":...}.
+ */
+
+// Function declarations
+void registerWebApi(WebServer &server);
+int8_t parseServoCommandName(const char *name);
+
+#endif // WEB_API_H
@@ -0,0 +1,55 @@
+#include "web_assets.h"
+#include "generated/web_assets_data.h"
+
+#define WEB_ASSET_COUNT (sizeof(WEB_ASSET_TABLE) / sizeof(WEB_ASSET_TABLE[0]))
+
+const WebAsset *findWebAsset(const char *name) {
+    for (const WebAsset &asset : WEB_ASSET_TABLE) {
+        if (strcmp(asset.name, name) == 0) {
+            return &asset;
+        }
+    }
+    return nullptr;
+}
+
+void registerWebAssets(WebServer &server) {
+    // The server only hands handlers the request headers it was told to keep
+    static const char *headerKeys[] = {"If-None-Match"};
+    server.collectHeaders(headerKeys, 1);
+    
+    for (const WebAsset &asset : WEB_ASSET_TABLE) {
+        server.on(String("/assets/") + asset.name, HTTP_GET, [&server, &asset]() {
+            sendWebAsset(server, asset);
+        });
+    }
+    Serial.printf("Web assets: %u files\n", (unsigned)WEB_ASSET_COUNT);
+}
+
+void sendWebAsset(WebServer &server, const WebAsset &asset) {
+    char etag[20];
+    snprintf(etag, sizeof(etag), "\"%s\"", asset.hash);
+    
+    // Pages are revalidated on every visit (a 304 while the firmware is
+    // unchanged); stylesheets and scripts are requested with ?v=<hash>, so a
+    // cached copy can be kept for good.
+    bool isPage = (strcmp(asset.contentType, "text/html") == 0);
+    server.sendHeader("ETag", etag);
+    server.sendHeader("Cache-Control", isPage ? "no-cache" : "public, max-age=31536000, immutable");
+    
+    if (server.hasHeader("If-None-Match") && strstr(server.header("If-None-Match").c_str(), etag) != nullptr) {
+        server.send(304);
+        return;
+    }
+    
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, asset.contentType, (PGM_P)asset.data, asset.length);
+}
+
+void sendWebAsset(WebServer &server, const char *name) {
+    const WebAsset *asset = findWebAsset(name);
+    if (asset == nullptr) {
+        server.send(404, "text/plain", "Not found");
+        return;
+    }
+    sendWebAsset(server, *asset);
+}
@@ -0,0 +1,28 @@
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+/**
+ * @brief A gzipped file from web/, embedded at build time
+ * 
+ * See tools/embed_web_assets.py. The hash is taken from the gzipped bytes,
+ * so it changes exactly when the file does; it serves as the ETag and as the
+ * ?v= version in asset URLs.
+ */
+struct WebAsset {
+    const char *name;          // File name in web/, served at /assets/<name>
+    const char *contentType;
+    const uint8_t *data;       // Gzipped content (flash)
+    size_t length;
+    const char *hash;          // 16 hex digits
+};
+
+// Function declarations
+const WebAsset *findWebAsset(const char *name);
+void registerWebAssets(WebServer &server);
+void sendWebAsset(WebServer &server, const WebAsset &asset);
+void sendWebAsset(WebServer &server, const char *name);
+
+#endif // WEB_ASSETS_H
@@ -0,0 +1,288 @@
+#include "web_pages.h"
+#include "web_assets.h"
+#include "wifi_controller.h"
+#include "servo_controller.h"
+#include "version.h"
+#include "config.h"
+#include "utils/page_writer.h"
+#include "utils/servo_easing.h"
+#include "utils/dcc_address_index.h"
+#include "core/servo_task.h"
+#include "core/servo_move_scheduler.h"
+
+/*
+ * Pages with live values: their text lives in flash as the fragments below
+ * and is streamed through a PageWriter with the values formatted in between.
+ * Stylesheets, scripts and the pages that fill themselves in from
+ * /api/servos are gzipped files from web/ (see web_assets.h).
+ */
+
+#define IP_FORMAT "%u.%u.%u.%u"
+#define IP_ARGS(ip) (ip)[0], (ip)[1], (ip)[2], (ip)[3]
+
+// ---------------------------------------------------------------------------
+// Home page
+// ---------------------------------------------------------------------------
+
+static const char HOME_HEAD[] PROGMEM = R"rawliteral(<!DOCTYPE html><html><head><title>ESP32 DCC Servo Controller</title>
+<meta charset='UTF-8'>
+<meta name='viewport' content='width=device-width, initial-scale=1'>
+)rawliteral";
+
+static const char HOME_BODY[] PROGMEM = R"rawliteral(<div class='container'>
+<h1>ESP32 DCC Servo Controller</h1>
+)rawliteral";
+
+static const char HOME_NAV[] PROGMEM = R"rawliteral(</div>
+<div class='nav-buttons'>
+<a href='/config' class='button'>WiFi Configuration</a>
+<a href='/servo' class='button'>Servo Control</a>
+<a href='/servo-config' class='button'>Servo Configuration</a>
+<a href='/dcc-debug' class='button'>DCC Debug Monitor</a>
+</div>
+</div></body></html>
+)rawliteral";
+
+// ---------------------------------------------------------------------------
+// WiFi configuration page
+// ---------------------------------------------------------------------------
+
+static const char CONFIG_HEAD[] PROGMEM = R"rawliteral(<!DOCTYPE html><html><head><title>WiFi Configuration</title>
+<meta charset='UTF-8'>
+<meta name='viewport' content='width=device-width, initial-scale=1'>
+)rawliteral";
+
+static const char CONFIG_FORM[] PROGMEM = R"rawliteral(<div class='container'>
+<h1>WiFi Configuration</h1>
+<form method='POST'>
+<div class='form-group'>
+<label for='mode'>WiFi Mode:</label>
+<select id='mode' name='mode'>
+)rawliteral";
+
+static const char CONFIG_SCAN[] PROGMEM = R"rawliteral(<button type='button' class='button' onclick='scanWiFiNetworks()' id='scanBtn'>Scan Networks</button>
+</div>
+<div id='networkList' class='network-list'>
+<label>Available Networks:</label>
+<select id='networkSelect' onchange='selectNetwork()' style='width:100%;margin-top:5px;'>
+<option value=''>Select a network...</option>
+</select>
+</div>
+</div>
+<div class='form-group'>
+<label for='stationPassword'>Station Password:</label>
+<div style='display:flex;align-items:center;gap:5px;'>
+)rawliteral";
+
+static const char CONFIG_TEST[] PROGMEM = R"rawliteral(<button type='button' class='button' onclick='togglePasswordVisibility("stationPassword")' style='padding:8px 12px;background:#666;'>👁</button>
+</div>
+<div style='margin-top:10px;'>
+<button type='button' class='button' onclick='testStationConnection()' id='testBtn' style='background:#28a745;'>Test Connection</button>
+<span id='testResult' style='margin-left:10px;font-weight:bold;'></span>
+</div>
+<div style='margin-top:5px;font-size:12px;color:#666;'>
+ℹ️ Note: Testing will temporarily switch networks. Communication may be interrupted during test - this is normal.
+</div>
+</div>
+<h3>Access Point Settings</h3>
+<div class='form-group'>
+<label for='apSSID'>AP SSID:</label>
+)rawliteral";
+
+static const char CONFIG_TAIL[] PROGMEM = R"rawliteral(<button type='button' class='button' onclick='togglePasswordVisibility("apPassword")' style='padding:8px 12px;background:#666;'>👁</button>
+</div>
+</div>
+<div class='button-group'>
+<button type='submit' class='button'>Save Configuration</button>
+<button type='button' class='button' onclick="location.href='/'">Cancel</button>
+</div>
+</form>
+<hr>
+<h3>Factory Reset</h3>
+<p>This will reset all WiFi settings to defaults and reset all servos to factory values.</p>
+<form method='POST' action='/factory-reset' onsubmit='return confirm("Are you sure you want to perform a factory reset?");'>
+<div style='text-align:center;'>
+<button type='submit' class='button danger'>Factory Reset</button>
+</div>
+</form>
+)rawliteral";
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+static const char *selectedIf(bool condition) {
+    return condition ? " selected" : "";
+}
+
+/**
+ * @brief Write a link to a stylesheet or script in web/, with its version
+ * @param page Page being written
+ * @param format Tag with one %s for the asset URL
+ * @param name Asset file name
+ */
+static void printAssetTag(PageWriter &page, const char *format, const char *name) {
+    const WebAsset *asset = findWebAsset(name);
+    char url[64];
+    snprintf(url, sizeof(url), "/assets/%s?v=%s", name, asset ? asset->hash : "");
+    page.printf(format, url);
+}
+
+static const char *getHostnameForPage() {
+    // Same fallback as getMDNSHostname(), without building a String
+    return (strlen(wifiConfig.hostname) > 0) ? wifiConfig.hostname : "dccservo";
+}
+
+// ---------------------------------------------------------------------------
+// Pages
+// ---------------------------------------------------------------------------
+
+void sendHomePage(WebServer &server) {
+    PageWriter page(server);
+    page.begin();
+    page.print(HOME_HEAD);
+    printAssetTag(page, "<link rel='stylesheet' href='%s'>\n</head><body>\n", "home.css");
+    page.print(HOME_BODY);
+    page.printf("<h2>Version: %s</h2>\n<div class='info-grid'>\n", SOFTWARE_VERSION);
+
+    // WiFi Status Card
+    page.print("<div class='info-card'>\n<h3>WiFi Status</h3>\n");
+    const char *mode = (wifiConfig.mode == DCC_WIFI_AP) ? "Access Point" :
+                       (wifiConfig.mode == DCC_WIFI_STATION) ? "Station" : "Disabled";
+    page.printf("<div class='info-item'><span class='info-label'>Mode:</span><span class='info-value'>%s</span></div>\n", mode);
+
+    if (wifiConfig.mode == DCC_WIFI_AP) {
+        IPAddress apIP = WiFi.softAPIP();
+        page.printf("<div class='info-item'><span class='info-label'>AP SSID:</span><span class='info-value'>%s</span></div>\n", wifiConfig.apSSID);
+        page.printf("<div class='info-item'><span class='info-label'>AP IP:</span><span class='info-value'>" IP_FORMAT "</span></div>\n", IP_ARGS(apIP));
+    }
+
+    if (wifiConfig.mode == DCC_WIFI_STATION) {
+        if (WiFi.status() == WL_CONNECTED) {
+            IPAddress stationIP = WiFi.localIP();
+            page.printf("<div class='info-item'><span class='info-label'>Connected to:</span><span class='info-value'>%s</span></div>\n", WiFi.SSID().c_str());
+            page.printf("<div class='info-item'><span class='info-label'>Station IP:</span><span class='info-value'>" IP_FORMAT "</span></div>\n", IP_ARGS(stationIP));
+        } else {
+            page.print("<div class='info-item'><span class='info-label'>Station:</span><span class='info-value'>Not connected</span></div>\n");
+        }
+    }
+    page.print("</div>\n");
+
+    // Device Information Card
+    uint8_t mac[6];
+    WiFi.macAddress(mac);
+    const char *hostname = getHostnameForPage();
+    page.print("<div class='info-card'>\n<h3>Device Information</h3>\n");
+    page.printf("<div class='info-item'><span class='info-label'>Hostname:</span><span class='info-value'>%s</span></div>\n", hostname);
+    page.printf("<div class='info-item'><span class='info-label'>MAC Address:</span><span class='info-value'>%02X:%02X:%02X:%02X:%02X:%02X</span></div>\n",
+                mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+    // Access methods section
+    page.print("<div class='info-item'><span class='info-label'>Access Methods:</span></div>\n");
+    if (WiFi.status() == WL_CONNECTED) {
+        IPAddress stationIP = WiFi.localIP();
+        page.printf("<div class='info-item' style='margin-left:20px;'><span class='info-label'>Direct IP:</span><span class='info-value'><a href='http://" IP_FORMAT "' target='_blank'>" IP_FORMAT "</a></span></div>\n",
+                    IP_ARGS(stationIP), IP_ARGS(stationIP));
+    }
+    if (wifiConfig.mode == DCC_WIFI_AP) {
+        IPAddress apIP = WiFi.softAPIP();
+        page.printf("<div class='info-item' style='margin-left:20px;'><span class='info-label'>AP Direct:</span><span class='info-value'><a href='http://" IP_FORMAT "' target='_blank'>" IP_FORMAT "</a></span></div>\n",
+                    IP_ARGS(apIP), IP_ARGS(apIP));
+    }
+    page.printf("<div class='info-item' style='margin-left:20px;'><span class='info-label'>mDNS Link:</span><span class='info-value'><a href='http://%s.local' target='_blank'>%s.local</a> <small style='color:#888;'>(if supported)</small></span></div>\n",
+                hostname, hostname);
+
+    page.printf("<div class='info-item'><span class='info-label'>Free Heap:</span><span class='info-value'>%lu bytes</span></div>\n",
+                (unsigned long)ESP.getFreeHeap());
+    page.printf("<div class='info-item'><span class='info-label'>Uptime:</span><span class='info-value'>%lu seconds</span></div>\n",
+                (unsigned long)(millis() / 1000));
+    page.printf("<div class='info-item'><span class='info-label'>Servo Moves:</span><span class='info-value'>%u moving, %u queued (max %u, peak %u/%u)</span></div>\n",
+                servoMoveScheduler.getMovingCount(), servoMoveScheduler.getWaitingCount(), servoMoveScheduler.getMaxConcurrent(),
+                servoMoveScheduler.getPeakMoving(), servoMoveScheduler.getPeakWaiting());
+    page.printf("<div class='info-item'><span class='info-label'>Servo Tick:</span><span class='info-value'>%lu &micro;s avg, %lu &micro;s max</span></div>\n",
+                (unsigned long)servoTask.getAvgPeriodUs(), (unsigned long)servoTask.getMaxPeriodUs());
+    page.print("</div>\n");
+
+    page.print(HOME_NAV);
+    page.end();
+}
+
+void sendWiFiConfigPage(WebServer &server) {
+    PageWriter page(server);
+    page.begin();
+    page.print(CONFIG_HEAD);
+    printAssetTag(page, "<link rel='stylesheet' href='%s'>\n</head><body>\n", "config.css");
+    page.print(CONFIG_FORM);
+
+    // WiFi Mode
+    page.printf("<option value='0'%s>Disabled</option>\n", selectedIf(wifiConfig.mode == DCC_WIFI_OFF));
+    page.printf("<option value='1'%s>Access Point Only</option>\n", selectedIf(wifiConfig.mode == DCC_WIFI_AP));
+    page.printf("<option value='2'%s>Station Only (with AP fallback)</option>\n", selectedIf(wifiConfig.mode == DCC_WIFI_STATION));
+    page.print("</select>\n</div>\n");
+
+    // Hostname Settings
+    page.print("<div class='form-group'>\n<label for='hostname'>Device Hostname:</label>\n");
+    page.printf("<input type='text' id='hostname' name='hostname' value='%s' maxlength='31' placeholder='dccservo' pattern='[a-zA-Z0-9-]{1,31}' title='Hostname must contain only letters, numbers, and hyphens'>\n",
+                wifiConfig.hostname);
+    page.print("<small style='color:#666;font-size:12px;margin-top:5px;display:block;'>Used for mDNS (e.g., hostname.local). Only letters, numbers, and hyphens allowed.</small>\n</div>\n");
+
+    // Station Settings
+    page.print("<h3>Station Settings</h3>\n<div class='form-group'>\n<label for='stationSSID'>Station SSID:</label>\n<div class='input-group'>\n");
+    page.printf("<input type='text' id='stationSSID' name='stationSSID' value='%s' maxlength='31' placeholder='Enter network name'>\n",
+                wifiConfig.stationSSID);
+    page.print(CONFIG_SCAN);
+    page.printf("<input type='password' id='stationPassword' name='stationPassword' value='%s' maxlength='63' placeholder='Enter password' style='flex:1;'>\n",
+                wifiConfig.stationPassword);
+    page.print(CONFIG_TEST);
+
+    // Access Point Settings
+    page.printf("<input type='text' id='apSSID' name='apSSID' value='%s' maxlength='31' placeholder='Access point name'>\n",
+                wifiConfig.apSSID);
+    page.print("</div>\n<div class='form-group'>\n<label for='apPassword'>AP Password:</label>\n<div style='display:flex;align-items:center;gap:5px;'>\n");
+    page.printf("<input type='password' id='apPassword' name='apPassword' value='%s' maxlength='63' placeholder='Access point password' style='flex:1;'>\n",
+                wifiConfig.apPassword);
+
+    // Buttons, factory reset and the scan/test scripts
+    page.print(CONFIG_TAIL);
+    printAssetTag(page, "<script src='%s'></script>\n</div></body></html>\n", "config.js");
+    page.end();
+}
+
+void sendServoData(WebServer &server) {
+    PageWriter page(server);
+    page.begin(200, "application/json");
+
+    const DccAddressing &addressing = dccAddressIndex.getAddressing();
+    page.printf("{\"version\":%d,\"addressing\":{\"mode\":\"%s\",\"boardBase\":%u,\"shift\":%u,\"maxBoardBase\":%d},\"servos\":[",
+                WEB_API_VERSION, addressing.mode == DCC_ADDRESS_MODE_BOARD ? "board" : "output", addressing.boardBase,
+                addressing.shift, DCC_MAX_BOARD_BASE);
+    for (int i = 0; i < TOTAL_PINS; i++) {
+        const VIRTUALSERVO &vs = virtualservo[i];
+        page.printf("%s{\"address\":%u,\"dccAddress\":%u,\"swing\":%u,\"offset\":%d,\"maxOffset\":%u,\"speed\":%u,\"easing\":%u,"
+                    "\"invert\":%s,\"state\":%u,\"position\":%u,\"aspects\":[",
+                    i ? "," : "", vs.address, dccAddressIndex.getServoAddress(i), vs.swing, vs.offset, getMaxAllowedOffset(vs.swing), vs.speed, vs.easing,
+                    vs.invert ? "true" : "false", vs.state, vs.position);
+        for (uint8_t n = 0; n < SERVO_ASPECT_COUNT; n++) {
+            if (vs.aspects[n] == SERVO_ASPECT_UNUSED) {
+                page.print(n ? ",null" : "null");
+            } else {
+                page.printf("%s%u", n ? "," : "", vs.aspects[n]);
+            }
+        }
+        page.print("]}");
+    }
+
+    page.print("],\"speeds\":[");
+    for (uint8_t preset = SPEED_INSTANT; preset < SPEED_PRESET_COUNT; preset++) {
+        uint16_t speed = getServoSpeedPreset(preset);
+        page.printf("%s{\"preset\":%u,\"speed\":%u,\"name\":\"%s\"}", preset ? "," : "", preset, speed, getServoSpeedName(speed));
+    }
+
+    page.print("],\"easings\":[");
+    for (uint8_t profile = 0; profile < EASING_COUNT; profile++) {
+        page.printf("%s\"%s\"", profile ? "," : "", getServoEasingName(profile));
+    }
+    page.print("]}");
+    page.end();
+}
+
@@ -0,0 +1,14 @@
+#ifndef WEB_PAGES_H
+#define WEB_PAGES_H
+
+#include <WebServer.h>
+#include "config.h"
+
+// Streamed pages with live values (static text in flash, chunked encoding)
+void sendHomePage(WebServer &server);
+void sendWiFiConfigPage(WebServer &server);
+
+// GET /api/v1/servos: configuration and state of every servo (see web_api.h)
+void sendServoData(WebServer &server);
+
+#endif // WEB_PAGES_H
@@ -59,6 +59,7 @@ void handleConfig();
 void handleServoControl();
 void handleServoConfig();
 void updateServoConfig();
+void handleStats();
 void handleFactoryReset();
 void handleTestWiFi();
 void handleNotFound();
@@ -70,5 +71,8 @@ void processWiFiCommands();
 void handleDccDebug();
 void handleDccDebugToggle();
 void handleDccDebugLog();
+void handleDccCapture();
+void handleDccCaptureStart();
+void handleDccCaptureStop();
 
 #endif // WIFI_CONTROLLER_H
@@ -0,0 +1,129 @@
+"""
+Gzip the web UI in web/ into src/generated/web_assets_data.h
+
+Run by PlatformIO before each build (extra_scripts in platformio.ini), or by
+hand with `python tools/embed_web_assets.py`. The header is only rewritten
+when its content changes, so unchanged assets do not trigger a rebuild.
+
+In HTML files, {{name.css}} / {{name.js}} become the versioned asset URL
+(/assets/name.css?v=<hash>) and {{DEFINE}} the value of that #define in
+src/config.h. Each asset's hash is taken from its gzipped bytes, so it only
+changes when the asset does; it is also the asset's ETag.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 (provided by PlatformIO)
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+WEB_DIR = os.path.join(PROJECT_DIR, "web")
+CONFIG_H = os.path.join(PROJECT_DIR, "src", "config.h")
+OUTPUT = os.path.join(PROJECT_DIR, "src", "generated", "web_assets_data.h")
+
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+}
+
+
+def read_defines():
+    defines = {}
+    with open(CONFIG_H, encoding="utf-8") as f:
+        for line in f:
+            m = re.match(r"\s*#define\s+(\w+)\s+([^\s/]+)", line)
+            if m:
+                defines[m.group(1)] = m.group(2)
+    return defines
+
+
+def compress(text):
+    # mtime=0 keeps the output (and so the hash) stable from build to build
+    return gzip.compress(text.encode("utf-8"), compresslevel=9, mtime=0)
+
+
+def symbol(name):
+    return "WEB_ASSET_" + re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def build_assets():
+    names = sorted(n for n in os.listdir(WEB_DIR) if os.path.splitext(n)[1] in CONTENT_TYPES)
+    defines = read_defines()
+    assets = {}
+
+    # Stylesheets and scripts first, so pages can refer to their hashes
+    for name in sorted(names, key=lambda n: n.endswith(".html")):
+        with open(os.path.join(WEB_DIR, name), encoding="utf-8") as f:
+            text = f.read()
+
+        if name.endswith(".html"):
+            def substitute(m):
+                key = m.group(1)
+                if key in assets:
+                    return "/assets/%s?v=%s" % (key, assets[key]["hash"])
+                if key in defines:
+                    return defines[key]
+                raise SystemExit("web/%s: unknown placeholder {{%s}}" % (name, key))
+            text = re.sub(r"\{\{([\w.-]+)\}\}", substitute, text)
+        elif "{{" in text:
+            text = re.sub(r"\{\{(\w+)\}\}", lambda m: defines[m.group(1)], text)
+
+        data = compress(text)
+        assets[name] = {
+            "data": data,
+            "size": len(text.encode("utf-8")),
+            "hash": hashlib.sha1(data).hexdigest()[:16],
+            "type": CONTENT_TYPES[os.path.splitext(name)[1]],
+        }
+    return assets
+
+
+def render(assets):
+    out = [
+        "// Generated by tools/embed_web_assets.py from web/ - do not edit",
+        "#ifndef WEB_ASSETS_DATA_H",
+        "#define WEB_ASSETS_DATA_H",
+        "",
+    ]
+    for name, asset in sorted(assets.items()):
+        out.append("// %s: %d bytes, %d gzipped" % (name, asset["size"], len(asset["data"])))
+        out.append("static const uint8_t %s[] PROGMEM = {" % symbol(name))
+        out.append(c_array(asset["data"]))
+        out.append("};")
+        out.append("")
+    out.append("static const WebAsset WEB_ASSET_TABLE[] = {")
+    for name, asset in sorted(assets.items()):
+        out.append('    {"%s", "%s", %s, sizeof(%s), "%s"},' %
+                   (name, asset["type"], symbol(name), symbol(name), asset["hash"]))
+    out.append("};")
+    out.append("")
+    out.append("#endif // WEB_ASSETS_DATA_H")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    text = render(build_assets())
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, encoding="utf-8") as f:
+            if f.read() == text:
+                return
+    os.makedirs(os.path.dirname(OUTPUT), exist_ok=True)
+    with open(OUTPUT, "w", encoding="utf-8") as f:
+        f.write(text)
+    print("Web assets embedded into %s" % os.path.relpath(OUTPUT, PROJECT_DIR))
+
+
+main()
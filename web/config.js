@@ -0,0 +1,147 @@
+function scanWiFiNetworks() {
+  console.log('WiFi scan button clicked');
+  const button = document.getElementById('scanBtn');
+  const networkSelect = document.getElementById('networkSelect');
+  const networkList = document.getElementById('networkList');
+  
+  if (!button || !networkSelect || !networkList) {
+    console.error('Required elements not found');
+    return;
+  }
+  
+  button.disabled = true;
+  button.textContent = 'Scanning...';
+  
+  console.log('Starting WiFi scan...');
+  fetch('/scan')
+    .then(response => {
+      console.log('Scan response status:', response.status);
+      if (!response.ok) {
+        throw new Error('Network response was not ok: ' + response.status);
+      }
+      return response.json();
+    })
+    .then(data => {
+      console.log('Scan response data:', JSON.stringify(data));
+      
+      // Clear existing options
+      networkSelect.innerHTML = '<option value="">Select a network...</option>';
+      
+      if (data && data.networks && Array.isArray(data.networks) && data.networks.length > 0) {
+        console.log('Processing', data.networks.length, 'networks');
+        data.networks.forEach((network, index) => {
+          console.log('Adding network:', network.ssid);
+          const option = document.createElement('option');
+          option.value = network.ssid;
+          option.textContent = network.ssid + ' (' + network.rssi + ' dBm, ' + network.encryption + ')';
+          networkSelect.appendChild(option);
+        });
+        console.log('Successfully added', data.networks.length, 'networks to dropdown');
+      } else {
+        console.log('No networks found in response or invalid data structure');
+        networkSelect.innerHTML += '<option value="" disabled>No networks found</option>';
+      }
+    })
+    .catch(error => {
+      console.error('Error scanning networks:', error);
+      networkSelect.innerHTML += '<option value="" disabled>Error scanning networks</option>';
+      alert('Error scanning networks: ' + error.message);
+    })
+    .finally(() => {
+      button.disabled = false;
+      button.textContent = 'Scan Networks';
+    });
+}
+
+function selectNetwork() {
+  console.log('Network selection changed');
+  const networkSelect = document.getElementById('networkSelect');
+  const stationSSID = document.getElementById('stationSSID');
+  
+  if (networkSelect && stationSSID && networkSelect.value) {
+    console.log('Setting SSID to:', networkSelect.value);
+    stationSSID.value = networkSelect.value;
+  }
+}
+
+function togglePasswordVisibility(fieldId) {
+  const passwordField = document.getElementById(fieldId);
+  const toggleButton = passwordField.nextElementSibling;
+  
+  if (passwordField.type === 'password') {
+    passwordField.type = 'text';
+    toggleButton.textContent = '🙈';
+    toggleButton.title = 'Hide password';
+  } else {
+    passwordField.type = 'password';
+    toggleButton.textContent = '👁';
+    toggleButton.title = 'Show password';
+  }
+}
+
+function testStationConnection() {
+  const stationSSID = document.getElementById('stationSSID').value.trim();
+  const stationPassword = document.getElementById('stationPassword').value;
+  const testBtn = document.getElementById('testBtn');
+  const testResult = document.getElementById('testResult');
+  
+  if (!stationSSID) {
+    testResult.textContent = '❌ Please enter an SSID';
+    testResult.style.color = '#dc3545';
+    return;
+  }
+  
+  if (!stationPassword || stationPassword.length < 8) {
+    testResult.textContent = '❌ Password must be at least 8 characters';
+    testResult.style.color = '#dc3545';
+    return;
+  }
+  
+  testBtn.disabled = true;
+  testBtn.textContent = 'Testing...';
+  testResult.textContent = '🔄 Testing connection...';
+  testResult.style.color = '#ffc107';
+  
+  fetch('/test-wifi', {
+    method: 'POST',
+    headers: {
+      'Content-Type': 'application/x-www-form-urlencoded'
+    },
+    body: 'ssid=' + encodeURIComponent(stationSSID) + '&password=' + encodeURIComponent(stationPassword)
+  })
+  .then(response => response.json())
+  .then(data => {
+    testBtn.disabled = false;
+    testBtn.textContent = 'Test Connection';
+    
+    if (data.success) {
+      testResult.textContent = '✅ Connection successful! Credentials automatically saved to EEPROM.';
+      testResult.style.color = '#28a745';
+    } else {
+      testResult.textContent = '❌ Connection failed: ' + (data.error || 'Unknown error');
+      testResult.style.color = '#dc3545';
+    }
+  })
+  .catch(error => {
+    testBtn.disabled = false;
+    testBtn.textContent = 'Test Connection';
+    
+    // Handle fetch failures gracefully - these are often expected during WiFi testing
+    if (error.message.includes('Failed to fetch') || error.message.includes('NetworkError')) {
+      testResult.textContent = '⚠️ Test connection may have succeeded - network switch interrupted communication';
+      testResult.style.color = '#ffc107'; // Warning color (yellow/orange)
+    } else {
+      testResult.textContent = '❌ Test failed: ' + error.message;
+      testResult.style.color = '#dc3545';
+    }
+  });
+}
+
+// Initialize page - clear any previous test results
+window.onload = function() {
+  const testResult = document.getElementById('testResult');
+  if (testResult) {
+    testResult.textContent = '';
+    testResult.style.color = '';
+  }
+};
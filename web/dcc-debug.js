@@ -0,0 +1,112 @@
+let autoRefresh = true;
+let refreshInterval;
+function showDebugMode(enabled) {
+  document.getElementById('debug-mode').textContent = enabled ? 'ENABLED' : 'DISABLED';
+  const btn = document.getElementById('debug-btn');
+  btn.textContent = enabled ? 'Disable Debug' : 'Enable Debug';
+  btn.className = 'btn ' + (enabled ? 'danger' : 'success');
+}
+function toggleDebug() {
+  fetch('/dcc-debug/toggle', { method: 'POST' })
+    .then(response => response.text())
+    .then(data => showDebugMode(data === 'DEBUG_ENABLED'));
+}
+function showCapture(capturing, packets) {
+  document.getElementById('capture-status').textContent = (capturing ? 'RECORDING' : 'STOPPED') + ', ' + packets + ' packets';
+}
+function startCapture(toFile) {
+  fetch('/dcc-capture/start' + (toFile ? '?file=1' : ''), { method: 'POST' })
+    .then(response => response.text())
+    .then(data => { if (data === 'CAPTURE_FAILED') alert('Could not start the capture file'); updateLog(); });
+}
+function stopCapture() {
+  fetch('/dcc-capture/stop', { method: 'POST' }).then(() => updateLog());
+}
+function loadAddresses() {
+  fetch('/api/v{{WEB_API_VERSION}}/servos')
+    .then(response => response.json())
+    .then(api => {
+      const addresses = api.servos.map(s => s.address).filter(a => a > 0);
+      document.getElementById('servo-addresses').textContent = addresses.length ? addresses.join(', ') : 'None configured';
+    });
+}
+let nextSeq = null;
+const maxShown = 1000;
+function logLine(cls, text) {
+  const div = document.createElement('div');
+  div.className = cls;
+  div.textContent = text;
+  return div;
+}
+function formatEntry(e) {
+  const t = e[0], addr = e[1], ev = e[2], f = e[3];
+  let cls = 'log-entry', msg;
+  if (ev === 0) {
+    msg = 'DCC RX: Addr=' + addr + ', Dir=' + (f & 1) + ', Pwr=' + ((f >> 1) & 1) + ((f & 4) ? ' [MATCH]' : ' [ignore]');
+    cls += (f & 4) ? ' log-match' : ' log-ignore';
+  } else if (ev === 1) {
+    msg = 'Servo action: Pin ' + addr + ' -> ' + ((f & 1) ? 'THROWN' : 'CLOSED');
+  } else if (ev === 2) {
+    msg = 'DCC signal triggered';
+  } else if (ev === 3) {
+    msg = 'DCC RX: Addr=' + addr + ', Aspect=' + (f >> 3) + ((f & 4) ? ' [MATCH]' : ' [ignore]');
+    cls += (f & 4) ? ' log-match' : ' log-ignore';
+  } else if (ev === 4) {
+    msg = 'Servo action: Pin ' + addr + ' -> ASPECT ' + (f >> 3);
+  } else {
+    msg = 'Unknown event ' + ev;
+  }
+  const div = logLine(cls, msg);
+  const ts = document.createElement('span');
+  ts.className = 'log-timestamp';
+  ts.textContent = (t / 1000).toFixed(3) + 's';
+  div.prepend(ts);
+  return div;
+}
+function updateLog() {
+  if (!autoRefresh) return;
+  fetch('/dcc-debug/log' + (nextSeq === null ? '' : '?since=' + nextSeq))
+    .then(response => response.json())
+    .then(data => {
+      showDebugMode(data.enabled);
+      showCapture(data.capturing, data.capture);
+      const log = document.getElementById('log-content');
+      const atBottom = log.scrollTop + log.clientHeight >= log.scrollHeight - 5;
+      if (data.reset || nextSeq === null) log.innerHTML = '';
+      if (data.lost > 0) log.appendChild(logLine('log-entry', '... ' + data.lost + ' entries overwritten before they were fetched ...'));
+      data.entries.forEach(e => log.appendChild(formatEntry(e)));
+      while (log.childElementCount > maxShown) log.removeChild(log.firstChild);
+      const empty = document.getElementById('log-empty');
+      if (log.childElementCount === 0) {
+        const line = logLine('log-entry', 'No DCC packets logged yet...');
+        line.id = 'log-empty';
+        log.appendChild(line);
+      } else if (empty && log.childElementCount > 1) {
+        empty.remove();
+      }
+      if (atBottom) log.scrollTop = log.scrollHeight;
+      nextSeq = data.next;
+      if (data.more) setTimeout(updateLog, 0);
+    });
+}
+function toggleAutoRefresh() {
+  autoRefresh = !autoRefresh;
+  const btn = document.getElementById('refresh-btn');
+  if (autoRefresh) {
+    btn.textContent = 'Pause Auto-Refresh';
+    btn.className = 'btn danger';
+    refreshInterval = setInterval(updateLog, 1000);
+  } else {
+    btn.textContent = 'Resume Auto-Refresh';
+    btn.className = 'btn success';
+    clearInterval(refreshInterval);
+  }
+}
+function clearLog() {
+  document.getElementById('log-content').innerHTML = '<div class="log-entry">Log cleared...</div>';
+}
+window.onload = function() {
+  loadAddresses();
+  updateLog();
+  refreshInterval = setInterval(updateLog, 1000);
+};
@@ -0,0 +1,185 @@
+function testServo(servo, command) {
+  fetch('/servo', {
+    method: 'POST',
+    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+    body: 'servo=' + servo + '&command=' + command
+  }).then(response => response.json())
+    .then(data => {
+      if (data.status === 'success') {
+        console.log('Servo ' + servo + ' ' + command + ' test sent');
+      } else {
+        alert('Error: ' + data.message);
+      }
+    }).catch(error => console.error('Error:', error));
+}
+
+// Configuration sections, built from /api/v1/servos
+let servoCount = 0;
+function option(value, label, selected) {
+  return "<option value='" + value + "'" + (selected ? ' selected' : '') + '>' + label + '</option>';
+}
+function addressingSection(a) {
+  return "<div class='servo-config'><h3>DCC Addressing</h3>" +
+    "<div class='form-row'>" +
+    "<div class='form-group'><label for='addrMode'>Mode</label>" +
+    "<select id='addrMode' onchange='showAddressing()'>" +
+    option('output', 'Address per servo', a.mode === 'output') + option('board', 'Block of boards', a.mode === 'board') + '</select></div>' +
+    "<div class='form-group' id='boardBaseGroup'><label for='boardBase'>First Board</label>" +
+    "<input type='number' id='boardBase' value='" + a.boardBase + "' min='1' max='" + a.maxBoardBase + "' oninput='showAddressing()'></div>" +
+    "<div class='form-group'><label for='addrShift'>Address Shift</label>" +
+    "<select id='addrShift'>" + option(0, 'None (RCN-213)', a.shift === 0) +
+    option(4, '+4 (board 0 is addresses 1-4, e.g. Roco)', a.shift === 4) + '</select></div>' +
+    '</div>' +
+    "<p id='blockInfo'></p>" +
+    "<div class='servo-save-controls'>" +
+    "<button type='button' class='button save-button' onclick='saveAddressing()'>Save Addressing</button></div>" +
+    '</div>';
+}
+function showAddressing() {
+  const board = document.getElementById('addrMode').value === 'board';
+  const base = parseInt(document.getElementById('boardBase').value) || 1;
+  document.getElementById('boardBaseGroup').style.display = board ? '' : 'none';
+  document.getElementById('blockInfo').textContent = board ?
+    'Boards ' + base + '-' + (base + servoCount / 4 - 1) + ': servo n answers to address ' + ((base - 1) * 4 + 1) + ' + n' :
+    'Each servo answers to its own DCC address';
+}
+// Aspect table as typed: percent of travel per aspect, '-' for unused
+function aspectList(aspects) {
+  const list = aspects.map(p => p === null ? '-' : p);
+  while (list.length && list[list.length - 1] === '-') list.pop();
+  return list.join(',');
+}
+function servoSection(api, s, i) {
+  const board = api.addressing.mode === 'board';
+  let speeds = api.speeds.map(p => option(p.preset, p.name, s.speed === p.speed)).join('');
+  if (!api.speeds.some(p => p.speed === s.speed)) {
+    // Explicit degrees/second speed (set from the serial console)
+    speeds += option(s.speed, s.speed + '&deg;/s', true);
+  }
+  const easings = api.easings.map((name, e) => option(e, name, s.easing === e)).join('');
+  return "<div class='servo-config'><h3>Servo " + i + '</h3>' +
+    "<div class='form-row'>" +
+    "<div class='form-group'><label for='addr" + i + "'>DCC Address</label>" +
+    "<input type='number' id='addr" + i + "' name='addr" + i + "' value='" + (board ? s.dccAddress : s.address) +
+    "' min='0' max='2048'" + (board ? " disabled title='Set by the board block'" : '') + '></div>' +
+    "<div class='form-group'><label for='swing" + i + "'>Swing (degrees)</label>" +
+    "<input type='number' id='swing" + i + "' name='swing" + i + "' value='" + s.swing + "' min='1' max='90'></div>" +
+    "<div class='form-group'><label for='offset" + i + "'>Offset (degrees)</label>" +
+    "<input type='number' id='offset" + i + "' name='offset" + i + "' value='" + s.offset + "' min='-" + s.maxOffset + "' max='" + s.maxOffset + "'></div>" +
+    "<div class='form-group'><label for='speed" + i + "'>Speed</label>" +
+    "<select id='speed" + i + "' name='speed" + i + "'>" + speeds + '</select></div>' +
+    "<div class='form-group'><label for='easing" + i + "'>Easing</label>" +
+    "<select id='easing" + i + "' name='easing" + i + "'>" + easings + '</select></div>' +
+    "<div class='form-group'><label for='invert" + i + "'>Invert</label>" +
+    "<select id='invert" + i + "' name='invert" + i + "'>" + option(0, 'No', !s.invert) + option(1, 'Yes', s.invert) + '</select></div>' +
+    "<div class='form-group'><label for='aspects" + i + "'>Signal Aspects (%)</label>" +
+    "<input type='text' id='aspects" + i + "' name='aspects" + i + "' value='" + aspectList(s.aspects) +
+    "' placeholder='e.g. 0,50,100' title='Position per aspect 0-" + (s.aspects.length - 1) + ", 0=closed to 100=thrown, - = unused'></div>" +
+    '</div>' +
+    "<div class='test-controls'><label style='margin-bottom:8px;text-align:center;'>Test Servo:</label>" +
+    "<button type='button' class='button test-button' onclick='testServo(" + i + ", \"close\")'>Close</button>" +
+    "<button type='button' class='button test-button' onclick='testServo(" + i + ", \"throw\")'>Throw</button>" +
+    "<button type='button' class='button test-button' onclick='testServo(" + i + ", \"neutral\")'>Neutral</button></div>" +
+    "<div class='servo-save-controls'>" +
+    "<button type='button' class='button save-button' onclick='saveServoConfig(" + i + ")'>Save Servo " + i + '</button></div>' +
+    '</div>';
+}
+function loadServos() {
+  fetch('/api/v{{WEB_API_VERSION}}/servos')
+    .then(response => response.json())
+    .then(api => {
+      servoCount = api.servos.length;
+      document.getElementById('addressing').innerHTML = addressingSection(api.addressing);
+      document.getElementById('servos').innerHTML = api.servos.map((s, i) => servoSection(api, s, i)).join('');
+      showAddressing();
+    }).catch(error => console.error('Error:', error));
+}
+
+function saveAddressing() {
+  const params = new URLSearchParams();
+  params.append('addrMode', document.getElementById('addrMode').value);
+  params.append('boardBase', document.getElementById('boardBase').value);
+  params.append('addrShift', document.getElementById('addrShift').value);
+
+  fetch('/servo-config', {
+    method: 'POST',
+    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+    body: params.toString()
+  }).then(response => response.json())
+    .then(data => {
+      alert(data.status === 'error' ? 'Error saving addressing: ' + data.message : data.message);
+      loadServos();
+    }).catch(error => {
+      console.error('Error:', error);
+      alert('Error saving addressing');
+    });
+}
+
+function saveServoConfig(servoIndex) {
+  const addrInput = document.getElementById('addr' + servoIndex);
+  const addr = addrInput.value;
+  const swing = document.getElementById('swing' + servoIndex).value;
+  const offset = document.getElementById('offset' + servoIndex).value;
+  const speed = document.getElementById('speed' + servoIndex).value;
+  const easing = document.getElementById('easing' + servoIndex).value;
+  const invert = document.getElementById('invert' + servoIndex).value;
+  const aspects = document.getElementById('aspects' + servoIndex).value;
+  
+  const params = new URLSearchParams();
+  params.append('servo', servoIndex);
+  if (!addrInput.disabled) params.append('addr' + servoIndex, addr);  // Board mode: kept for output mode
+  params.append('swing' + servoIndex, swing);
+  params.append('offset' + servoIndex, offset);
+  params.append('speed' + servoIndex, speed);
+  params.append('easing' + servoIndex, easing);
+  params.append('invert' + servoIndex, invert);
+  params.append('aspects' + servoIndex, aspects);
+  
+  fetch('/servo-config', {
+    method: 'POST',
+    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+    body: params.toString()
+  }).then(response => response.json())
+    .then(data => {
+      if (data.status === 'success') {
+        alert('Servo ' + servoIndex + ' configuration saved successfully!');
+      } else {
+        alert('Error saving servo ' + servoIndex + ' configuration: ' + data.message);
+      }
+    }).catch(error => {
+      console.error('Error:', error);
+      alert('Error saving servo ' + servoIndex + ' configuration');
+    });
+}
+
+function saveAllConfigs() {
+  const form = document.getElementById('servoConfigForm');
+  const formData = new FormData(form);
+  const params = new URLSearchParams(formData);
+  
+  fetch('/servo-config', {
+    method: 'POST',
+    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+    body: params.toString()
+  }).then(response => response.json())
+    .then(data => {
+      if (data.status === 'success') {
+        alert(data.message);
+      } else if (data.status === 'no_changes') {
+        alert(data.message);
+      } else {
+        alert('Error saving configuration: ' + data.message);
+      }
+    }).catch(error => {
+      console.error('Error:', error);
+      alert('Error saving configuration');
+    });
+}
+
+function loadDefaults() {
+  if (confirm('Are you sure you want to load default values for all servos?')) {
+    location.reload();
+  }
+}
+
+loadServos();
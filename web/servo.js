@@ -0,0 +1,73 @@
+function controlServo(servo, command) {
+  fetch('/servo', {
+    method: 'POST',
+    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+    body: 'servo=' + servo + '&command=' + command
+  }).then(response => response.json())
+    .then(data => {
+      if (data.status === 'success') {
+        console.log('Servo ' + servo + ' ' + command + ' command sent');
+      } else {
+        alert('Error: ' + data.message);
+      }
+    }).catch(error => console.error('Error:', error));
+}
+
+// Servo table, built from /api/v1/servos
+function speedLabel(api, speed) {
+  const preset = api.speeds.find(p => p.speed === speed);
+  return preset ? preset.name : speed + '°/s';
+}
+function loadServos() {
+  fetch('/api/v{{WEB_API_VERSION}}/servos')
+    .then(response => response.json())
+    .then(api => {
+      const rows = document.getElementById('servos');
+      rows.innerHTML = '';
+      api.servos.forEach((s, i) => {
+        const row = rows.insertRow();
+        [i, s.address, s.swing, s.offset, speedLabel(api, s.speed), s.invert ? 'Yes' : 'No', '-'].forEach(value => {
+          row.insertCell().textContent = value;
+        });
+        row.cells[0].style.fontWeight = 'bold';
+        row.cells[6].id = 'state' + i;
+        showState(i, s.state);
+        const actions = document.createElement('div');
+        actions.className = 'action-buttons';
+        [['close', 'Close'], ['throw', 'Throw'], ['neutral', 'Neutral']].forEach(([command, label]) => {
+          const button = document.createElement('button');
+          button.className = 'button button-' + command;
+          button.textContent = label;
+          button.onclick = () => controlServo(i, command);
+          actions.appendChild(button);
+        });
+        row.insertCell().appendChild(actions);
+      });
+    }).catch(error => console.error('Error:', error));
+}
+
+// Live servo state, DCC matches and health over the event socket
+const stateNames = ['Neutral', 'Moving to thrown', 'Thrown', 'Moving to closed', 'Closed', 'Booting', 'Moving to aspect', 'Aspect'];
+function showState(servo, state) {
+  const cell = document.getElementById('state' + servo);
+  if (cell) cell.textContent = stateNames[state] || state;
+}
+function connectEvents() {
+  const ws = new WebSocket('ws://' + location.hostname + ':{{EVENT_SOCKET_PORT}}/');
+  ws.onopen = () => ws.send(JSON.stringify({subscribe: ['servo', 'dcc', 'health']}));
+  ws.onmessage = msg => {
+    const data = JSON.parse(msg.data);
+    if (data.servos) data.servos.forEach((s, i) => showState(i, s[0]));
+    if (data.ev) data.ev.forEach(e => {
+      if (e[0] === 's') showState(e[2], e[3]);
+      else document.getElementById('lastDcc').textContent = 'DCC ' + e[2] + (e[0] === 'a' ? ' aspect ' + e[3] : (e[3] ? ' thrown' : ' closed')) + ' at ' + (e[1] / 1000).toFixed(1) + 's';
+    });
+    if (data.health) {
+      const h = data.health;
+      document.getElementById('health').textContent = 'Uptime ' + Math.floor(h.uptimeMs / 1000) + 's, heap ' + h.freeHeap + ' bytes, ' + h.movesActive + ' moving, ' + h.movesQueued + ' queued, ' + h.lateTicks + ' late ticks';
+    }
+  };
+  ws.onclose = () => setTimeout(connectEvents, 3000);
+}
+loadServos();
+connectEvents();